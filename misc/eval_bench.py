@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+
+import argparse
+import os
+import subprocess
+import sys
+import time
+from pathlib import Path
+
+from openings import parse_opening
+
+
+def parse_nodes(text: str) -> int:
+    scale = {'K': 10**3, 'M': 10**6, 'G': 10**9, 'T': 10**12}
+    if text and text[-1] in scale:
+        return int(float(text[:-1]) * scale[text[-1]])
+    return int(text)
+
+
+def load_games(filepath: str, count: int) -> list[list[tuple[int, int]]]:
+    games = []
+    with open(filepath, 'r') as f:
+        for line in f:
+            moves = parse_opening(line.strip())
+            if moves:
+                games.append(moves)
+            if len(games) >= count:
+                break
+    return games
+
+
+def bench_engine(rapfi_path: str, games: list[list[tuple[int, int]]], board_size: int,
+                 depth: int, nodes: int) -> dict:
+    proc = subprocess.Popen(
+        [rapfi_path],
+        stdin=subprocess.PIPE,
+        stdout=subprocess.PIPE,
+        stderr=subprocess.DEVNULL,
+        text=True,
+        bufsize=1
+    )
+
+    def send(cmd: str):
+        proc.stdin.write(cmd + '\n')
+        proc.stdin.flush()
+
+    def read_until(prefix: str) -> list[str]:
+        lines = []
+        while True:
+            line = proc.stdout.readline()
+            if not line:
+                raise RuntimeError(f'{rapfi_path} exited unexpectedly')
+            line = line.strip()
+            lines.append(line)
+            if line.startswith(prefix):
+                return lines
+
+    send(f'START {board_size}')
+    read_until('OK')
+    send(f'INFO max_depth {depth}')
+    send(f'INFO max_node {nodes}')
+
+    stats = {'plies': 0, 'searches': 0, 'nodes': 0, 'depth': 0, 'ms': 0.0}
+    for moves in games:
+        for ply, (x, y) in enumerate(moves):
+            send('YXBOARD')
+            for i, (px, py) in enumerate(moves[:ply]):
+                send(f'{px},{py},{1 if i % 2 == ply % 2 else 2}')
+            send('DONE')
+
+            start = time.monotonic()
+            send(f'ANALYZE_MOVE {x},{y}')
+            lines = read_until('EVAL_DATA')
+            stats['ms'] += (time.monotonic() - start) * 1000
+
+            depths = [0]
+            for line in lines:
+                if line.startswith('MESSAGE Speed') and '| Node ' in line:
+                    stats['searches'] += 1
+                    stats['nodes'] += parse_nodes(line.split('| Node ')[1].split()[0])
+                    depths.append(int(line.split('| Depth ')[1].split('-')[0]))
+            stats['depth'] += min(depths[1:], default=0)
+            stats['plies'] += 1
+
+    send('END')
+    try:
+        proc.wait(timeout=5)
+    except subprocess.TimeoutExpired:
+        proc.kill()
+        proc.wait()
+    return stats
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Benchmark ANALYZE_MOVE cost per ply')
+    parser.add_argument('rapfi', nargs='+', help='Paths to pbrain-rapfi builds to compare')
+    parser.add_argument('--games', type=str, default=None,
+                        help='Game records, one per line (default: openings.txt)')
+    parser.add_argument('--count', '-n', type=int, default=20,
+                        help='Number of games to analyse')
+    parser.add_argument('--board-size', type=int, default=20,
+                        help='Board size')
+    parser.add_argument('--depth', type=int, default=12,
+                        help='Search depth per analysed ply')
+    parser.add_argument('--nodes', type=int, default=0,
+                        help='Node limit per search (0 for none)')
+    args = parser.parse_args()
+
+    script_dir = Path(__file__).parent.resolve()
+    games = load_games(args.games or str(script_dir / 'openings.txt'), args.count)
+    if not games:
+        print('[ERROR] No games to analyse')
+        sys.exit(1)
+
+    print(f'{"engine":<40} {"plies":>6} {"search/ply":>11} {"nodes/ply":>11} {"min depth":>9} '
+          f'{"ms/ply":>8}')
+    for rapfi_path in args.rapfi:
+        if not os.path.isfile(rapfi_path) or not os.access(rapfi_path, os.X_OK):
+            print(f'[ERROR] Rapfi not found or not executable: {rapfi_path}')
+            sys.exit(1)
+
+        s = bench_engine(rapfi_path, games, args.board_size, args.depth, args.nodes)
+        plies = max(s['plies'], 1)
+        print(f'{rapfi_path:<40} {s["plies"]:>6} {s["searches"] / plies:>11.2f} '
+              f'{s["nodes"] / plies:>11.0f} {s["depth"] / plies:>9.1f} {s["ms"] / plies:>8.1f}')
+
+
+if __name__ == '__main__':
+    main()
@@ -621,6 +621,16 @@ void turn()
     think(*board);
 }
 
+void place()
+{
+    auto pos = parseLegalCoord(std::cin, *board);
+    if (!pos.has_value())
+        return;
+
+    board->move(options.rule, *pos);
+    std::cout << "OK" << std::endl;
+}
+
 void getPosition(bool startThink)
 {
     board->newGame(options.rule);
@@ -1257,18 +1267,21 @@ void loadModel()
     loadModelFromFile(modelPath);
 }
 
-void analyzeMove()
+struct MoveEval
+{
+    float pBest   = 0.0f;
+    float pSecond = 0.0f;
+    float pPlayed = 0.0f;
+};
+
+/// Search the current board and report win rates of the best, second best
+/// and played move. The played move is forced into the root search so that
+/// it gets an exact value in the same search as the two PV lines. Only when
+/// it is missing from the root moves (e.g. pruned by a forced defence) does
+/// a second search restricted to it take place. The transposition table is
+/// left untouched.
+MoveEval evaluatePlayedMove(Pos playedMove)
 {
-    int x, y;
-    char comma;
-    std::cin >> x >> comma >> y;
-
-    Pos playedMove = inputCoordConvert(x, y, board->size());
-    if (!board->isLegal(playedMove)) {
-        ERRORL("Illegal move coordinates");
-        return;
-    }
-
     uint16_t originalMultiPV = options.multiPV;
     bool originalTimeLimit = options.timeLimit;
     Time originalMatchTime = options.matchTime;
@@ -1277,45 +1290,36 @@ void analyzeMove()
     options.multiPV = 2;
     options.balanceMode = Search::SearchOptions::BALANCE_NONE;
     options.restrictMoves.clear();
+    options.includeMove = playedMove;
     options.timeLimit = false;
     options.matchTime = 0;
 
-
-    if (Search::Threads.main()->inPonder) {
-        Search::Threads.stopThinking();
-        Search::Threads.waitForIdle();
-    }
-
-    Search::TT.clear();
-    Search::Threads.clear(false);
     Search::Threads.startThinking(*board, options);
     Search::Threads.waitForIdle();
 
     const auto& rootMoves = Search::Threads.main()->rootMoves;
 
-    float pBest = 0.0f;
-    float pSecond = 0.0f;
-    float pPlayed = 0.0f;
+    // A line cut off by the node limit keeps its last completed value in previousValue
+    auto lastValue = [](const Search::RootMove& rm) {
+        return rm.value != VALUE_NONE ? rm.value : rm.previousValue;
+    };
+
+    MoveEval e;
     bool playedFound = false;
 
-    if (rootMoves.size() > 0) {
-        pBest = Config::valueToWinRate(rootMoves[0].value);
-        if (rootMoves[0].pv[0] == playedMove) {
-            pPlayed = pBest;
-            playedFound = true;
-        }
-    }
+    if (rootMoves.size() > 0)
+        e.pBest = Config::valueToWinRate(lastValue(rootMoves[0]));
+    if (rootMoves.size() > 1)
+        e.pSecond = Config::valueToWinRate(lastValue(rootMoves[1]));
 
-    if (rootMoves.size() > 1) {
-        pSecond = Config::valueToWinRate(rootMoves[1].value);
-        if (rootMoves[1].pv[0] == playedMove) {
-            pPlayed = pSecond;
-            playedFound = true;
-        }
-    } else {
-        pSecond = 0.0f;
+    auto played = std::find(rootMoves.begin(), rootMoves.end(), playedMove);
+    if (played != rootMoves.end() && lastValue(*played) != VALUE_NONE) {
+        e.pPlayed = Config::valueToWinRate(lastValue(*played));
+        playedFound = true;
     }
 
+    options.includeMove = Pos::NONE;
+
     if (!playedFound) {
         options.multiPV = 1;
         options.restrictMoves = { playedMove };
@@ -1324,11 +1328,8 @@ void analyzeMove()
         Search::Threads.waitForIdle();
 
         const auto& forcedRootMoves = Search::Threads.main()->rootMoves;
-        if (!forcedRootMoves.empty()) {
-            pPlayed = Config::valueToWinRate(forcedRootMoves[0].value);
-        } else {
-            pPlayed = 0.0f;
-        }
+        if (!forcedRootMoves.empty())
+            e.pPlayed = Config::valueToWinRate(forcedRootMoves[0].value);
 
         options.restrictMoves.clear();
     }
@@ -1337,9 +1338,87 @@ void analyzeMove()
     options.timeLimit = originalTimeLimit;
     options.matchTime = originalMatchTime;
     options.maxNodes = originalMaxNodes;
+    return e;
+}
+
+void analyzeMove()
+{
+    int x, y;
+    char comma;
+    std::cin >> x >> comma >> y;
+
+    Pos playedMove = inputCoordConvert(x, y, board->size());
+    if (!board->isLegal(playedMove)) {
+        ERRORL("Illegal move coordinates");
+        return;
+    }
+
+    if (Search::Threads.main()->inPonder) {
+        Search::Threads.stopThinking();
+        Search::Threads.waitForIdle();
+    }
+
+    Search::TT.clear();
+    Search::Threads.clear(false);
+    MoveEval e = evaluatePlayedMove(playedMove);
 
     std::cout << std::fixed << std::setprecision(4);
-    std::cout << "EVAL_DATA " << pBest << " " << pSecond << " " << pPlayed << std::endl;
+    std::cout << "EVAL_DATA " << e.pBest << " " << e.pSecond << " " << e.pPlayed << std::endl;
+}
+
+/// Analyse a whole game record given as "x,y" lines terminated by DONE.
+/// Plies from the last one back to <first> are searched with a shared
+/// transposition table, so later positions seed the earlier searches.
+/// Streams "EVAL_DATA <best> <second> <played> <ply>" per ply, then DONE.
+void analyzeGame()
+{
+    int first = 1;
+    std::cin >> first;
+
+    std::vector<Pos> moves;
+    board->newGame(options.rule);
+    bool legal = true;
+
+    while (true) {
+        std::string coordStr;
+        std::cin >> coordStr;
+        upperInplace(coordStr);
+        if (coordStr == "DONE" || std::cin.eof())
+            break;
+        if (!legal)
+            continue;
+
+        int x = -1, y = -1;
+        char comma;
+        std::stringstream ss(coordStr);
+        ss >> x >> comma >> y;
+
+        Pos pos = inputCoordConvert(x, y, board->size());
+        if (!board->isLegal(pos)) {
+            ERRORL("Illegal move in game record at ply " << moves.size() + 1);
+            legal = false;
+            continue;
+        }
+        board->move(options.rule, pos);
+        moves.push_back(pos);
+    }
+
+    if (Search::Threads.main()->inPonder) {
+        Search::Threads.stopThinking();
+        Search::Threads.waitForIdle();
+    }
+
+    Search::TT.clear();
+    Search::Threads.clear(false);
+
+    std::cout << std::fixed << std::setprecision(4);
+    for (int ply = (int)moves.size(); ply >= std::max(first, 1); ply--) {
+        board->undo(options.rule);
+        MoveEval e = evaluatePlayedMove(moves[ply - 1]);
+        std::cout << "EVAL_DATA " << e.pBest << " " << e.pSecond << " " << e.pPlayed << " "
+                  << ply << std::endl;
+    }
+    std::cout << "DONE" << std::endl;
 }
 
 /// Enter protocol loop once and fetch and execute one command from stdin.
@@ -1382,7 +1461,8 @@ bool runProtocol()
      && cmd != "YXQUERYDATABASEONE"
      && cmd != "YXQUERYDATABASETEXT"
      && cmd != "YXQUERYDATABASEALLT"
-     && cmd != "ANALYZE_MOVE")      Search::Threads.stopThinking();
+     && cmd != "ANALYZE_MOVE"
+     && cmd != "ANALYZE_GAME")      Search::Threads.stopThinking();
 
     if (cmd == "ABOUT")                    std::cout << getEngineInfo() << std::endl;
     else if (cmd == "START")               start();
@@ -1407,6 +1487,7 @@ bool runProtocol()
     else if (cmd == "TAKEBACK")            CheckBoardOK(takeBack);
     else if (cmd == "BEGIN")               CheckBoardOK(begin);
     else if (cmd == "TURN")                CheckBoardOK(turn);
+    else if (cmd == "PLACE")               CheckBoardOK(place);
     else if (cmd == "BOARD")               CheckBoardOK([] { getPosition(true); });
     else if (cmd == "YXBOARD")             CheckBoardOK([] { getPosition(false); });
     else if (cmd == "YXBLOCK")             CheckBoardOK([] { getBlock(false); });
@@ -1432,6 +1513,7 @@ bool runProtocol()
     else if (cmd == "TRACEBOARD")          CheckBoardOK(traceBoard);
     else if (cmd == "TRACESEARCH")         CheckBoardOK(traceSearch);
     else if (cmd == "ANALYZE_MOVE")        CheckBoardOK(analyzeMove);
+    else if (cmd == "ANALYZE_GAME")        CheckBoardOK(analyzeGame);
     else if (!GUIMode)                     ERRORL("Unknown command: " << cmd);
     // clang-format on
 
@@ -69,6 +69,7 @@ void ABSearchData::clearData(SearchThread &th)
 {
     multiPv         = 1;
     pvIdx           = 0;
+    pvLast          = 0;
     rootDepth       = 0;
     completedDepth  = 0;
     bestMoveChanges = 0;
@@ -275,6 +276,7 @@ void ABSearcher::search(SearchThread &th)
         }
 
         // MultiPV loop. We perform a full root search for each PV line
+        sd.pvLast = th.rootMoves.size();
         for (sd.pvIdx = 0; sd.pvIdx < sd.multiPv && !th.threads.isTerminating(); ++sd.pvIdx) {
             // Reset selDepth for each depth and each PV line
             th.selDepth = 0;
@@ -302,6 +304,27 @@ void ABSearcher::search(SearchThread &th)
                                  RootMoveValueComparator {});
         }
 
+        // If the include move is not among the PV lines, search it alone as an extra line
+        // so that it gets an exact value within the same iteration. A pure analysis search
+        // always runs to maxDepth, so only its last iteration needs the extra line.
+        if (options.includeMove && options.balanceMode != SearchOptions::BALANCE_TWO
+            && (!options.isAnalysisMode() || sd.rootDepth >= maxDepth)
+            && !th.threads.isTerminating()) {
+            auto pvEnd   = th.rootMoves.begin() + sd.multiPv;
+            auto include = std::find(pvEnd, th.rootMoves.end(), options.includeMove);
+            if (include != th.rootMoves.end()) {
+                std::rotate(pvEnd, include, include + 1);
+                sd.pvIdx    = sd.multiPv;
+                sd.pvLast   = sd.pvIdx + 1;
+                th.selDepth = 0;
+                aspirationSearch(options.rule,
+                                 *th.board,
+                                 stackArray.rootStack(),
+                                 th.rootMoves[sd.pvIdx].previousValue,
+                                 Depth(sd.rootDepth));
+            }
+        }
+
         // If search is complete, update completed depth.
         if (!th.threads.isTerminating()) {
             sd.completedDepth = sd.rootDepth;
@@ -498,11 +521,11 @@ void aspirationSearch(Rule rule, Board &board, SearchStack *ss, Value prevValue,
         // When in balance mode, sort according to negetive absolute value.
         if (thisThread->options().balanceMode)
             std::stable_sort(thisThread->rootMoves.begin() + searchData->pvIdx,
-                             thisThread->rootMoves.end(),
+                             thisThread->rootMoves.begin() + searchData->pvLast,
                              BalanceMoveValueComparator {});
         else
             std::stable_sort(thisThread->rootMoves.begin() + searchData->pvIdx,
-                             thisThread->rootMoves.end(),
+                             thisThread->rootMoves.begin() + searchData->pvLast,
                              RootMoveValueComparator {});
 
         // If search has been stopped, break immediately. Sorting result is safe to use.
@@ -967,7 +990,7 @@ moves_loop:
             }
             // Skip moves not in root move list and PV moves that have been already searched
             else if (!std::count(thisThread->rootMoves.begin() + searchData->pvIdx,
-                                 thisThread->rootMoves.end(),
+                                 thisThread->rootMoves.begin() + searchData->pvLast,
                                  move))
                 continue;
 
@@ -1354,7 +1377,7 @@ moves_loop:
         if (RootNode) {
             // All remaining losing root moves are marked with this value
             std::for_each(thisThread->rootMoves.begin() + searchData->pvIdx,
-                          thisThread->rootMoves.end(),
+                          thisThread->rootMoves.begin() + searchData->pvLast,
                           [=](RootMove &rm) { rm.value = bestValue; });
         }
     }
@@ -34,6 +34,7 @@ struct ABSearchData : SearchData
 {
     uint32_t         multiPv;          /// Current number of multi pv
     uint32_t         pvIdx;            /// Current searched pv index
+    uint32_t         pvLast;           /// End of root moves searched in current pv line
     int              rootDepth;        /// Current searched depth
     Value            rootDelta;        /// Current window size of the root node
     Value            rootAlpha;        /// Current alpha value of the root node
@@ -160,6 +160,9 @@ struct SearchOptions
     /// Blocked moves, which are filtered out before searching
     std::vector<Pos> blockMoves;
     std::vector<Pos> restrictMoves;
+    /// Root move that always gets an exact value in MultiPV mode, even when it
+    /// falls outside the PV lines (Pos::NONE to disable, ignored in balance2)
+    Pos includeMove = Pos::NONE;
 
     /// Checks if we are in analysis mode.
     bool isAnalysisMode() const { return !timeLimit && !maxNodes; }
@@ -344,6 +344,8 @@ void ThreadPool::startThinking(const Board          &board,
         if (main()->board->isInBoard(p))
             main()->board->expandCandArea(p, 4, 4);
     }
+    if (main()->board->isInBoard(options.includeMove))
+        main()->board->expandCandArea(options.includeMove, 4, 4);
 
     auto addMoveToRootMoves = [this](Pos m) {
         // Ignore blocked moves
@@ -420,9 +422,12 @@ void ThreadPool::startThinking(const Board          &board,
 
         if (rootMoveList.size() < main()->rootMoves.size()) {
             // Remove root moves that are not in the filtered list
-            auto pred = [&rootMoveList](const Search::RootMove &rm) -> bool {
-                return std::find(rootMoveList.begin(), rootMoveList.end(), rm.pv[0])
-                       == rootMoveList.end();
+            // The include move is kept even if a symmetric twin has been chosen
+            auto pred = [&rootMoveList,
+                         include = options.includeMove](const Search::RootMove &rm) -> bool {
+                return rm.pv[0] != include
+                       && std::find(rootMoveList.begin(), rootMoveList.end(), rm.pv[0])
+                              == rootMoveList.end();
             };
             main()->rootMoves.erase(
                 std::remove_if(main()->rootMoves.begin(), main()->rootMoves.end(), pred),
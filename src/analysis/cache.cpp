@@ -1,28 +1,271 @@
 #include "cache.h"
-#include "../core/constants.h"
-#include <mutex>
+#include "../core/logger.h"
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace Arena::Analysis {
 
-    std::shared_mutex GlobalCache::mtx_;
-    std::vector<GlobalCache::Entry> GlobalCache::table_;
+    namespace {
+        constexpr char CACHE_MAGIC[8] = {'A', 'R', 'E', 'N', 'A', 'E', 'V', 'C'};
+        constexpr size_t WAYS = Core::Constants::CACHE_BUCKET_WAYS;
 
-    void GlobalCache::init(int size) {
-        std::unique_lock<std::shared_mutex> l(mtx_);
+        uint64_t fnv1a(const std::string& s) {
+            uint64_t h = 1469598103934665603ULL;
+            for (unsigned char c : s) {
+                h ^= c;
+                h *= 1099511628211ULL;
+            }
+            return h;
+        }
+
+        size_t bucket_count(size_t entries) {
+            size_t n = 1;
+            while (n * 2 * WAYS <= entries) n *= 2;
+            return n;
+        }
+
+        uint64_t to_bits(double d) {
+            uint64_t u;
+            std::memcpy(&u, &d, sizeof(u));
+            return u;
+        }
+
+        double from_bits(uint64_t u) {
+            double d;
+            std::memcpy(&d, &u, sizeof(d));
+            return d;
+        }
+    }
+
+    std::mutex GlobalCache::mtx_;
+    std::unique_ptr<GlobalCache::Bucket[]> GlobalCache::table_;
+    GlobalCache::Bucket* GlobalCache::buckets_ = nullptr;
+    size_t GlobalCache::count_ = 0;
+    void* GlobalCache::map_ = nullptr;
+    size_t GlobalCache::map_len_ = 0;
+    int GlobalCache::fd_ = -1;
+    std::atomic<uint64_t> GlobalCache::hits_{0};
+    std::atomic<uint64_t> GlobalCache::misses_{0};
+    std::atomic<uint64_t> GlobalCache::evictions_{0};
+    std::atomic<uint64_t> GlobalCache::loaded_{0};
+
+    void GlobalCache::init(int size, size_t entries) {
+        std::lock_guard<std::mutex> l(mtx_);
         Zobrist::init(size);
-        if (table_.empty()) table_.resize(Core::Constants::CACHE_MAX_SIZE);
+        if (map_) return;
+        size_t n = bucket_count(entries);
+        if (!buckets_ || count_ != n) {
+            table_.reset(new Bucket[n]());
+            buckets_ = table_.get();
+            count_ = n;
+        }
+    }
+
+    bool GlobalCache::open(const std::string& path, const Identity& id) {
+        std::lock_guard<std::mutex> l(mtx_);
+        if (map_) return true;
+
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            Core::Logger::log(
+                Core::Logger::Level::WARN,
+                "Eval cache: cannot open ", path, ": ", std::strerror(errno)
+            );
+            return false;
+        }
+        if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+            Core::Logger::log(
+                Core::Logger::Level::WARN,
+                "Eval cache: ", path, " is in use by another process"
+            );
+            ::close(fd);
+            return false;
+        }
+
+        size_t n = count_ ? count_ : bucket_count(Core::Constants::CACHE_DEFAULT_SIZE);
+        size_t len = sizeof(Header) + n * sizeof(Bucket);
+        struct stat st{};
+        bool resized = fstat(fd, &st) != 0 || (size_t)st.st_size != len;
+        if (resized && (ftruncate(fd, 0) != 0 || ftruncate(fd, (off_t)len) != 0)) {
+            Core::Logger::log(
+                Core::Logger::Level::WARN,
+                "Eval cache: cannot size ", path, ": ", std::strerror(errno)
+            );
+            ::close(fd);
+            return false;
+        }
+
+        void* m = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (m == MAP_FAILED) {
+            Core::Logger::log(
+                Core::Logger::Level::WARN,
+                "Eval cache: cannot map ", path, ": ", std::strerror(errno)
+            );
+            ::close(fd);
+            return false;
+        }
+
+        auto* hdr = static_cast<Header*>(m);
+        char* data = static_cast<char*>(m) + sizeof(Header);
+        auto* b = reinterpret_cast<Bucket*>(data);
+        uint64_t ident = fnv1a(id.evaluator);
+
+        const char* reset = nullptr;
+        if (std::memcmp(hdr->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+            hdr->version != Core::Constants::CACHE_FILE_VERSION ||
+            hdr->buckets != n)
+            reset = resized && st.st_size == 0
+                ? "created" : "format or size changed, starting empty";
+        else if (hdr->identity != ident || hdr->board_size != (uint64_t)id.board_size ||
+                 hdr->eval_nodes != id.eval_nodes)
+            reset = "evaluator settings changed, starting empty";
+        else if (!hdr->clean)
+            reset = "not closed cleanly, starting empty";
+
+        uint64_t loaded = 0;
+        if (reset) {
+            std::memset(data, 0, n * sizeof(Bucket));
+            std::memcpy(hdr->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+            hdr->version = Core::Constants::CACHE_FILE_VERSION;
+            hdr->buckets = n;
+            hdr->identity = ident;
+            hdr->board_size = (uint64_t)id.board_size;
+            hdr->eval_nodes = id.eval_nodes;
+        } else {
+            for (size_t i = 0; i < n; ++i)
+                for (const auto& s : b[i].slots)
+                    if (s.stamp.load(std::memory_order_relaxed)) loaded++;
+        }
+        hdr->clean = 0;
+        msync(m, sizeof(Header), MS_SYNC);
+
+        map_ = m;
+        map_len_ = len;
+        fd_ = fd;
+        buckets_ = b;
+        count_ = n;
+        table_.reset();
+        loaded_ = loaded;
+
+        if (reset)
+            Core::Logger::log(Core::Logger::Level::INFO, "Eval cache: ", path, " ", reset);
+        else
+            Core::Logger::log(
+                Core::Logger::Level::INFO,
+                "Eval cache: loaded ", loaded, " positions from ", path
+            );
+        return true;
+    }
+
+    void GlobalCache::close() {
+        std::lock_guard<std::mutex> l(mtx_);
+        if (!map_) return;
+        static_cast<Header*>(map_)->clean = 1;
+        msync(map_, map_len_, MS_SYNC);
+        munmap(map_, map_len_);
+        ::close(fd_);
+        map_ = nullptr;
+        map_len_ = 0;
+        fd_ = -1;
+        buckets_ = nullptr;
+        count_ = 0;
+    }
+
+    int GlobalCache::find(
+        const Bucket& b, uint64_t h, uint64_t nodes, Stats::EvalMetrics* out
+    ) {
+        for (int tries = 0; tries < Core::Constants::CACHE_READ_RETRIES; ++tries) {
+            uint32_t seq = b.seq.load(std::memory_order_acquire);
+            if (seq & 1) continue;
+
+            int found = -1;
+            for (size_t i = 0; i < WAYS && found < 0; ++i) {
+                const Slot& s = b.slots[i];
+                if (!s.stamp.load(std::memory_order_relaxed) ||
+                    s.hash.load(std::memory_order_relaxed) != h ||
+                    s.nodes.load(std::memory_order_relaxed) != nodes)
+                    continue;
+                found = (int)i;
+                if (out) {
+                    out->p_best = from_bits(s.metrics[0].load(std::memory_order_relaxed));
+                    out->p_second = from_bits(s.metrics[1].load(std::memory_order_relaxed));
+                    out->p_played = from_bits(s.metrics[2].load(std::memory_order_relaxed));
+                }
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (b.seq.load(std::memory_order_relaxed) == seq) return found;
+        }
+        return -1;
     }
 
-    std::optional<Stats::EvalMetrics> GlobalCache::get(uint64_t h) {
-        size_t idx = h & (Core::Constants::CACHE_MAX_SIZE - 1);
-        std::shared_lock<std::shared_mutex> l(mtx_);
-        if (table_[idx].hash != h) return std::nullopt;
-        return table_[idx].metrics;
+    std::optional<Stats::EvalMetrics> GlobalCache::get(uint64_t h, uint64_t nodes) {
+        Stats::EvalMetrics m;
+        if (buckets_ && find(buckets_[h & (count_ - 1)], h, nodes, &m) >= 0) {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return m;
+        }
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    bool GlobalCache::contains(uint64_t h, uint64_t nodes) {
+        return buckets_ && find(buckets_[h & (count_ - 1)], h, nodes, nullptr) >= 0;
+    }
+
+    void GlobalCache::set(uint64_t h, Stats::EvalMetrics v, uint64_t nodes) {
+        if (!buckets_) return;
+        Bucket& b = buckets_[h & (count_ - 1)];
+
+        uint32_t seq = b.seq.load(std::memory_order_relaxed);
+        do {
+            while (seq & 1) seq = b.seq.load(std::memory_order_relaxed);
+        } while (!b.seq.compare_exchange_weak(
+            seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed
+        ));
+        std::atomic_thread_fence(std::memory_order_release);
+
+        size_t slot = WAYS;
+        for (size_t i = 0; i < WAYS && slot == WAYS; ++i) {
+            const Slot& s = b.slots[i];
+            if (s.stamp.load(std::memory_order_relaxed) &&
+                s.hash.load(std::memory_order_relaxed) == h &&
+                s.nodes.load(std::memory_order_relaxed) == nodes)
+                slot = i;
+        }
+        for (size_t i = 0; i < WAYS && slot == WAYS; ++i)
+            if (!b.slots[i].stamp.load(std::memory_order_relaxed)) slot = i;
+        if (slot == WAYS) {
+            slot = 0;
+            for (size_t i = 1; i < WAYS; ++i) {
+                const Slot& s = b.slots[i];
+                const Slot& cur = b.slots[slot];
+                uint64_t sn = s.nodes.load(std::memory_order_relaxed);
+                uint64_t cn = cur.nodes.load(std::memory_order_relaxed);
+                if (sn < cn || (sn == cn && s.stamp.load(std::memory_order_relaxed) <
+                                            cur.stamp.load(std::memory_order_relaxed)))
+                    slot = i;
+            }
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Slot& s = b.slots[slot];
+        s.hash.store(h, std::memory_order_relaxed);
+        s.nodes.store(nodes, std::memory_order_relaxed);
+        s.metrics[0].store(to_bits(v.p_best), std::memory_order_relaxed);
+        s.metrics[1].store(to_bits(v.p_second), std::memory_order_relaxed);
+        s.metrics[2].store(to_bits(v.p_played), std::memory_order_relaxed);
+        s.stamp.store(++b.clock, std::memory_order_relaxed);
+
+        b.seq.store(seq + 2, std::memory_order_release);
     }
 
-    void GlobalCache::set(uint64_t h, Stats::EvalMetrics v) {
-        size_t idx = h & (Core::Constants::CACHE_MAX_SIZE - 1);
-        std::unique_lock<std::shared_mutex> l(mtx_);
-        table_[idx] = {h, v};
+    GlobalCache::Counters GlobalCache::counters() {
+        return {hits_.load(), misses_.load(), evictions_.load(), loaded_.load()};
     }
 }
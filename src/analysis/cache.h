@@ -1,29 +1,78 @@
 #pragma once
 
-#include <shared_mutex>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 #include <optional>
+#include "../core/constants.h"
 #include "../stats/metrics.h"
 #include "zobrist.h"
 
 namespace Arena::Analysis {
     class GlobalCache {
     public:
-        static void init(int size);
-        static std::optional<Stats::EvalMetrics> get(uint64_t h);
-        static void set(uint64_t h, Stats::EvalMetrics v);
+        struct Identity {
+            std::string evaluator;
+            int board_size = 0;
+            uint64_t eval_nodes = 0;
+        };
+
+        struct Counters {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t evictions = 0;
+            uint64_t loaded = 0;
+        };
 
-        static uint64_t hash(const std::vector<Core::Point>& moves, int sz) {
-            return Zobrist::hash(moves, sz);
+        static void init(int size, size_t entries = Core::Constants::CACHE_DEFAULT_SIZE);
+        static bool open(const std::string& path, const Identity& id);
+        static void close();
+        static bool persistent() { return map_ != nullptr; }
+        static size_t capacity() { return count_ * Core::Constants::CACHE_BUCKET_WAYS; }
+        static std::optional<Stats::EvalMetrics> get(uint64_t h, uint64_t nodes = 0);
+        static bool contains(uint64_t h, uint64_t nodes = 0);
+        static void set(uint64_t h, Stats::EvalMetrics v, uint64_t nodes = 0);
+        static Counters counters();
+
+        static uint64_t hash(const Core::MoveList& moves, int sz) {
+            return Zobrist::canonical(moves, sz);
         }
 
     private:
-        struct Entry {
-            uint64_t hash = 0;
-            Stats::EvalMetrics metrics;
+        struct Slot {
+            std::atomic<uint64_t> hash;
+            std::atomic<uint64_t> nodes;
+            std::atomic<uint64_t> stamp;
+            std::atomic<uint64_t> metrics[3];
         };
 
-        static std::shared_mutex mtx_;
-        static std::vector<Entry> table_;
+        struct Bucket {
+            std::atomic<uint32_t> seq;
+            uint32_t clock;
+            Slot slots[Core::Constants::CACHE_BUCKET_WAYS];
+        };
+
+        struct Header {
+            char magic[8];
+            uint32_t version;
+            uint32_t clean;
+            uint64_t buckets;
+            uint64_t identity;
+            uint64_t board_size;
+            uint64_t eval_nodes;
+        };
+
+        static int find(const Bucket& b, uint64_t h, uint64_t nodes, Stats::EvalMetrics* out);
+
+        static std::mutex mtx_;
+        static std::unique_ptr<Bucket[]> table_;
+        static Bucket* buckets_;
+        static size_t count_;
+        static void* map_;
+        static size_t map_len_;
+        static int fd_;
+        static std::atomic<uint64_t> hits_, misses_, evictions_, loaded_;
     };
 }
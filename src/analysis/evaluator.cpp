@@ -2,6 +2,7 @@
 #include "../core/constants.h"
 #include "../core/logger.h"
 #include "../sys/signals.h"
+#include <algorithm>
 #include <regex>
 #include <sstream>
 
@@ -23,6 +24,7 @@ Evaluator::Evaluator(
 }
 
 bool Evaluator::start() {
+    synced_valid_ = false;
     if (!proc_->start(0)) {
         Core::Logger::log(
             Core::Logger::Level::ERROR,
@@ -45,6 +47,7 @@ bool Evaluator::start() {
 
     send_cmd("INFO timeout_turn 0");
     send_cmd("INFO timeout_match 0");
+    send_cmd("INFO rule " + std::to_string(static_cast<int>(rule_)));
     send_cmd("INFO THREAD_NUM " +
         std::to_string(Core::Constants::PROTOCOL_THREAD_NUM));
     send_cmd("INFO MAX_NODE " + std::to_string(max_nodes_));
@@ -64,16 +67,24 @@ void Evaluator::set_max_nodes(uint64_t nodes) {
 }
 
 Stats::EvalMetrics Evaluator::eval(
-    const std::vector<Core::Point>& moves)
+    const Core::MoveList& moves)
 {
     try {
         if (moves.empty()) return {};
+        bool delta = sync_board(moves, moves.size() - 1);
+        send_analyze(moves.back());
+        auto res = parse_eval_response();
+        if (!desync_) return res;
+
+        if (debug_) {
+            Core::Logger::log(
+                Core::Logger::Level::DEBUG,
+                "Evaluator desync on move ", moves.size(), ", resending board"
+            );
+        }
+        if (!delta) return res;
         send_board(moves, moves.size() - 1);
-        auto& last = moves.back();
-        send_cmd(
-            "ANALYZE_MOVE " + std::to_string(last.x) +
-            "," + std::to_string(last.y)
-        );
+        send_analyze(moves.back());
         return parse_eval_response();
     } catch (const Core::MatchTerminated&) {
         throw;
@@ -96,6 +107,81 @@ Stats::EvalMetrics Evaluator::eval(
     }
 }
 
+std::optional<std::vector<Stats::EvalMetrics>> Evaluator::eval_game(
+    const Core::MoveList& moves, size_t first)
+{
+    if (!game_supported_ || moves.empty() || first < 1 || first > moves.size())
+        return std::nullopt;
+
+    static const std::regex ply_re(R"(EVAL_DATA\s+(\S+)\s+(\S+)\s+(\S+)\s+(\d+)\s*$)");
+    std::vector<Stats::EvalMetrics> res(moves.size() + 1);
+    synced_valid_ = false;
+
+    try {
+        send_cmd("ANALYZE_GAME " + std::to_string(first));
+        for (size_t i = 0; i < moves.size(); ++i)
+            send_cmd(std::to_string(moves[i].x) + "," + std::to_string(moves[i].y));
+        send_cmd("DONE");
+
+        size_t got = 0;
+        bool done = false;
+        std::smatch m;
+        while (auto l = proc_->read_line(cutoff_, nullptr)) {
+            if (debug_)
+                Core::Logger::log(Core::Logger::Level::DEBUG, "<- EVAL: ", *l);
+            if (*l == "DONE") {
+                done = true;
+                break;
+            }
+            if (l->rfind("ERROR", 0) == 0) {
+                if (l->find("Unknown command") != std::string::npos) {
+                    game_supported_ = false;
+                    break;
+                }
+                continue;
+            }
+            if (!std::regex_search(*l, m, ply_re)) continue;
+            size_t ply = std::stoul(m[4]);
+            if (ply < first || ply > moves.size()) continue;
+            res[ply] = {std::stod(m[1]), std::stod(m[2]), std::stod(m[3])};
+            got++;
+        }
+
+        if (!done) {
+            if (game_supported_) {
+                Core::Logger::log(
+                    Core::Logger::Level::WARN,
+                    "Evaluator timed out on game of ", moves.size(),
+                    " moves, restarting"
+                );
+            }
+            restart();
+            return std::nullopt;
+        }
+        if (got != moves.size() - first + 1) return std::nullopt;
+        synced_ = moves.prefix(first - 1);
+        synced_valid_ = true;
+        return res;
+    } catch (const Core::MatchTerminated&) {
+        throw;
+    } catch (const std::exception& e) {
+        Core::Logger::log(
+            Core::Logger::Level::WARN,
+            "Evaluator failed on game of ", moves.size(), " moves: ", e.what()
+        );
+        if (exit_on_crash_) {
+            Core::Logger::log(
+                Core::Logger::Level::ERROR,
+                "STRICT MODE: Exiting due to evaluator error: ", e.what()
+            );
+            Sys::g_stop_flag = 1;
+            throw Core::MatchTerminated();
+        }
+        restart();
+        return std::nullopt;
+    }
+}
+
 void Evaluator::send_cmd(const std::string& cmd) {
     if (debug_) {
         Core::Logger::log(
@@ -105,9 +191,50 @@ void Evaluator::send_cmd(const std::string& cmd) {
     proc_->write_line(cmd);
 }
 
+void Evaluator::send_analyze(const Core::Point& p) {
+    send_cmd(
+        "ANALYZE_MOVE " + std::to_string(p.x) +
+        "," + std::to_string(p.y)
+    );
+}
+
+bool Evaluator::sync_board(
+    const Core::MoveList& moves, size_t count)
+{
+    if (incremental_ && synced_valid_) {
+        size_t k = 0;
+        if (synced_.record() == moves.record())
+            k = std::min(synced_.size(), count);
+        else
+            while (k < synced_.size() && k < count && synced_[k] == moves[k]) ++k;
+        size_t undo = synced_.size() - k;
+        size_t put = count - k;
+
+        if (undo + put <= count) {
+            for (size_t i = synced_.size(); i > k; --i) {
+                send_cmd("TAKEBACK " + std::to_string(synced_[i - 1].x) +
+                    "," + std::to_string(synced_[i - 1].y));
+            }
+            for (size_t i = k; i < count; ++i) {
+                send_cmd("PLACE " + std::to_string(moves[i].x) +
+                    "," + std::to_string(moves[i].y));
+            }
+            synced_ = moves.prefix(count);
+            delta_syncs_++;
+            return true;
+        }
+    }
+
+    send_board(moves, count);
+    return false;
+}
+
 void Evaluator::send_board(
-    const std::vector<Core::Point>& moves, size_t count)
+    const Core::MoveList& moves, size_t count)
 {
+    synced_ = moves.prefix(count);
+    synced_valid_ = true;
+    full_syncs_++;
     send_cmd("YXBOARD");
     for (size_t i = 0; i < count; ++i) {
         std::stringstream ss;
@@ -119,12 +246,20 @@ void Evaluator::send_board(
 }
 
 Stats::EvalMetrics Evaluator::parse_eval_response() {
-    static const std::regex eval_re(R"(EVAL_DATA\s+(\S+)\s+(\S+)\s+(\S+))");
+    static const std::regex eval_re(R"(EVAL_DATA\s+(\S+)\s+(\S+)\s+(\S+)\s*$)");
     std::smatch m;
+    desync_ = false;
 
     while (auto l = proc_->read_line(cutoff_, nullptr)) {
         if (debug_)
             Core::Logger::log(Core::Logger::Level::DEBUG, "<- EVAL: ", *l);
+        if (l->rfind("ERROR", 0) == 0) {
+            desync_ = true;
+            synced_valid_ = false;
+            if (l->find("Unknown command") != std::string::npos)
+                incremental_ = false;
+            continue;
+        }
         if (std::regex_search(*l, m, eval_re)) {
             Stats::EvalMetrics res;
             res.p_best = std::stod(m[1]);
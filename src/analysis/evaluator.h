@@ -7,6 +7,7 @@
 #include <memory>
 #include "../sys/process.h"
 #include "../core/types.h"
+#include "../core/game_record.h"
 #include "../stats/metrics.h"
 
 namespace Arena::Analysis {
@@ -19,16 +20,27 @@ namespace Arena::Analysis {
         );
         bool start();
         void restart();
-        Stats::EvalMetrics eval(const std::vector<Core::Point>& moves);
+        Stats::EvalMetrics eval(const Core::MoveList& moves);
+        std::optional<std::vector<Stats::EvalMetrics>> eval_game(
+            const Core::MoveList& moves, size_t first
+        );
+        bool game_supported() const { return game_supported_; }
         void set_max_nodes(uint64_t nodes);
         void set_debug(bool d) { debug_ = d; }
+        void set_rule(Core::Rule r) { rule_ = r; }
         pid_t pid() const { return proc_->pid(); }
+        long long cpu_ns() const { return proc_->get_cpu_ns(); }
+        const Core::MoveList& synced() const { return synced_; }
+        uint64_t full_syncs() const { return full_syncs_; }
+        uint64_t delta_syncs() const { return delta_syncs_; }
 
     friend class EvaluatorTest;
 
     private:
         void send_cmd(const std::string& cmd);
-        void send_board(const std::vector<Core::Point>& moves, size_t count);
+        void send_board(const Core::MoveList& moves, size_t count);
+        bool sync_board(const Core::MoveList& moves, size_t count);
+        void send_analyze(const Core::Point& p);
         Stats::EvalMetrics parse_eval_response();
 
         std::unique_ptr<Sys::Process> proc_;
@@ -37,6 +49,15 @@ namespace Arena::Analysis {
         int cutoff_;
         bool exit_on_crash_;
         uint64_t max_nodes_;
+        Core::Rule rule_ = Core::Rule::FREESTYLE;
         bool debug_ = false;
+
+        Core::MoveList synced_;
+        bool synced_valid_ = false;
+        bool incremental_ = true;
+        bool desync_ = false;
+        bool game_supported_ = true;
+        uint64_t full_syncs_ = 0;
+        uint64_t delta_syncs_ = 0;
     };
 }
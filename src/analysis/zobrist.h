@@ -1,10 +1,12 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <cstdint>
 #include <random>
 #include "../core/constants.h"
 #include "../core/types.h"
+#include "../core/game_record.h"
 
 namespace Arena::Analysis {
     class Zobrist {
@@ -16,18 +18,84 @@ namespace Arena::Analysis {
             for (auto& k : keys_) k = rng();
         }
 
+        static uint64_t key(int color, Core::Point p, int sz) {
+            int idx = color * sz * sz + (p.y * sz + p.x);
+            if (idx < 0 || idx >= (int)keys_.size()) return 0;
+            return keys_[idx];
+        }
+
         static uint64_t hash(const std::vector<Core::Point>& moves, int sz) {
             if (keys_.empty()) return 0;
             uint64_t h = 0;
             for (size_t i = 0; i < moves.size(); ++i) {
                 int color = (i % 2) ? 1 : 2;
-                int idx = color * sz * sz + (moves[i].y * sz + moves[i].x);
-                if (idx >= 0 && idx < (int)keys_.size()) h ^= keys_[idx];
+                h ^= key(color, moves[i], sz);
             }
             return h;
         }
 
+        static uint64_t canonical(const Core::MoveList& moves, int sz);
+
     private:
         static std::vector<uint64_t> keys_;
     };
+
+    class SymmetricHash {
+    public:
+        static constexpr int SYMMETRIES = 8;
+
+        explicit SymmetricHash(int size) : size_(size) {}
+
+        void push(Core::Point p) {
+            toggle(p, (count_ % 2) ? 1 : 2);
+            count_++;
+        }
+
+        void pop(Core::Point p) {
+            count_--;
+            toggle(p, (count_ % 2) ? 1 : 2);
+        }
+
+        uint64_t key(Core::Point played) const {
+            uint64_t best = ~0ULL;
+            for (int s = 0; s < SYMMETRIES; ++s) {
+                uint64_t k = lanes_[s] ^ Zobrist::key(0, transform(played, s, size_), size_);
+                if (k < best) best = k;
+            }
+            return best;
+        }
+
+        size_t size() const { return count_; }
+
+        static Core::Point transform(Core::Point p, int sym, int size) {
+            int n = size - 1;
+            switch (sym) {
+                case 1: return {n - p.y, p.x};
+                case 2: return {n - p.x, n - p.y};
+                case 3: return {p.y, n - p.x};
+                case 4: return {n - p.x, p.y};
+                case 5: return {p.x, n - p.y};
+                case 6: return {p.y, p.x};
+                case 7: return {n - p.y, n - p.x};
+                default: return p;
+            }
+        }
+
+    private:
+        void toggle(Core::Point p, int color) {
+            for (int s = 0; s < SYMMETRIES; ++s)
+                lanes_[s] ^= Zobrist::key(color, transform(p, s, size_), size_);
+        }
+
+        int size_;
+        size_t count_ = 0;
+        std::array<uint64_t, SYMMETRIES> lanes_{};
+    };
+
+    inline uint64_t Zobrist::canonical(const Core::MoveList& moves, int sz) {
+        if (moves.empty()) return 0;
+        SymmetricHash h(sz);
+        for (size_t i = 0; i + 1 < moves.size(); ++i) h.push(moves[i]);
+        return h.key(moves.back());
+    }
 }
@@ -1,6 +1,7 @@
 #include "cli.h"
 #include "../core/constants.h"
 #include "../core/utils.h"
+#include "../game/rules.h"
 #include <iostream>
 #include <thread>
 #include <algorithm>
@@ -19,10 +20,14 @@ Core::BatchConfig CLI::parse_batch_args(int argc, char* argv[]) {
         std::cout << "PLAYERS\n"
             << "  -1, --p1 <cmd>               player 1 executable (required)\n"
             << "  -2, --p2 <cmd>               player 2 executable (required)\n"
-            << "  -e, --eval <cmd>             evaluator engine for quality metrics\n\n";
+            << "  -e, --eval <cmd>             evaluator engine for quality metrics\n"
+            << "  --engine <cmd>               add a tournament engine (repeatable)\n"
+            << "  --tournament <mode>          round-robin (default) or gauntlet: first engine\n"
+            << "                               plays every other one\n\n";
 
         std::cout << "GAME SETTINGS\n"
             << "  -s, --size <int>             board size, 5-40 (default: 20)\n"
+            << "      --rule <name>            freestyle, standard or renju (default: freestyle)\n"
             << "  -o, --openings <file>        opening positions file\n"
             << "  --shuffle-openings           randomize opening order\n\n";
 
@@ -37,27 +42,56 @@ Core::BatchConfig CLI::parse_batch_args(int argc, char* argv[]) {
             << "  Memory: k, m (default), g. Nodes override time control (deterministic).\n"
             << "  Long forms: --p1-memory, --p2-max-nodes, --eval-max-nodes, etc.\n\n"
             << "  -l[1|2], --memory            limit memory (default: unlimited)\n"
-            << "  -N[1|2|e], --max-nodes       search node limit (evaluator default: 15M)\n\n";
+            << "  -N[1|2|e], --max-nodes       search node limit (evaluator default: 15M)\n"
+            << "  --cgroup <dir>               run each bot in its own cgroup v2 leaf under dir\n"
+            << "  --cgroup-cpus <float>        CPU quota per bot in cores (default: unlimited)\n"
+            << "  --cgroup-cpuset <list>       confine bots to these CPUs: 0-3,8\n\n";
 
         std::cout << "MATCH CONTROL\n"
             << "  -m, --min-pairs <int>        minimum pairs before early stop (default: 5)\n"
             << "  -M, --max-pairs <int>        maximum pairs to play (default: 10)\n"
             << "  -r, --risk <float>           early stop confidence threshold (default: 0)\n"
-            << "  -j, --threads <int>          concurrent games (default: 4)\n\n";
+            << "  --sprt <elo0>,<elo1>         stop on a pentanomial GSPRT between Elo bounds\n"
+            << "  --sprt-alpha <float>         SPRT false positive rate (default: 0.05)\n"
+            << "  --sprt-beta <float>          SPRT false negative rate (default: 0.05)\n"
+            << "  -j, --threads <int>          worker threads (default: 4)\n"
+            << "  --concurrency <int>          concurrent games (default: threads)\n"
+            << "  --reuse-engines              keep bots alive across games (RESTART)\n"
+            << "  --prespawn <int>             start bots for the next N queued games early\n"
+            << "  --pin                        give each bot and evaluator its own physical core\n"
+            << "  --oversubscribe              let --pin share cores when there are too few\n\n";
+
+        std::cout << "EVALUATOR SERVICE\n"
+            << "  --eval-procs <int>           evaluator processes (default: threads)\n"
+            << "  --eval-queue <int>           pending positions before games block (default: 4096)\n"
+            << "  --eval-idle <time>           stop idle evaluators after (default: 30s)\n"
+            << "  --eval-cpus <list>           pin evaluators to these CPUs: 0,1,2\n"
+            << "  --eval-game                  analyze each finished game in one request\n"
+            << "  --eval-cache <file>          keep analyzed positions in this file across runs\n"
+            << "  --eval-cache-size <int>      cache capacity in positions (default: 1048576)\n\n";
 
         std::cout << "BATCH MODE\n"
             << "  Comma-separated lists (no spaces): -N 250k,500k,1m -M 25,50\n"
             << "  Arena generates Cartesian product; tournaments processed sequentially.\n"
             << "  Per-player lists (-N1, -N2) enable asymmetric comparison.\n\n"
             << "  --repeat <int>               run each configuration N times (default: 1)\n"
-            << "  --seed <int,...>             explicit seeds to rotate through\n\n";
+            << "  --seed <int,...>             explicit seeds to rotate through\n"
+            << "  --adaptive                   interleave runs, give pairs to the least certain\n"
+            << "  --budget <int>               total pairs across all runs (needs --adaptive)\n\n";
+
+        std::cout << "TUNING\n"
+            << "  --tune <file>                SPSA-tune -1 against itself; one pair per iteration\n"
+            << "                               file lines: name, value, min, max, c_end, r_end\n"
+            << "  --tune-checkpoint <file>     save parameters here and resume from it\n\n";
 
         std::cout << "API AND OUTPUT\n"
             << "  --api-url <url>              remote endpoint for live results\n"
             << "  --api-key <key>              API authentication key\n"
             << "  --debounce <time>            API batch interval (default: half of announce)\n"
             << "  --cleanup                    clear API database before starting\n"
-            << "  --export-results <file>      NDJSON output, one line per finished config\n\n";
+            << "  --export-results <file>      NDJSON output, one line per finished config\n"
+            << "  --journal <file>             log every finished game so the batch can resume\n"
+            << "  --resume                     continue the batch recorded in --journal\n\n";
 
         std::cout << "DEBUGGING\n"
             << "  -b, --show-board             print board after each move\n"
@@ -74,7 +108,8 @@ Core::BatchConfig CLI::parse_batch_args(int argc, char* argv[]) {
 
         std::cout << "ENVIRONMENT VARIABLES\n"
             << "  THREADS, MEMORY, SIZE, OPENINGS, TIMEOUT_ANNOUNCE, TIMEOUT_CUTOFF,\n"
-            << "  TIMEOUT_GAME, MAX_PAIRS, MIN_PAIRS, RISK, API_URL, API_KEY, DEBOUNCE\n\n";
+            << "  TIMEOUT_GAME, MAX_PAIRS, MIN_PAIRS, RISK, API_URL, API_KEY, DEBOUNCE,\n"
+            << "  CONCURRENCY\n\n";
 
         std::cout << "METRICS\n"
             << "  Elo        relative strength from win/loss/draw outcomes\n"
@@ -108,6 +143,17 @@ Core::BatchConfig CLI::parse_batch_args(int argc, char* argv[]) {
         return std::nullopt;
     };
 
+    auto consume_signed = [&](const std::string& flag) -> std::optional<std::string> {
+        for (size_t i = 0; i + 1 < args.size(); ++i) {
+            if (args[i] != flag) continue;
+            args[i].clear();
+            std::string val = std::move(args[i + 1]);
+            args[i + 1].clear();
+            return val;
+        }
+        return consume(flag);
+    };
+
     auto consume_flag = [&](const std::string& flag) -> bool {
         for (auto& arg : args) if (arg == flag) { arg.clear(); return true; }
         return false;
@@ -151,10 +197,31 @@ Core::BatchConfig CLI::parse_batch_args(int argc, char* argv[]) {
     bc.p1_cmd = get_str("-1", "--p1", nullptr);
     bc.p2_cmd = get_str("-2", "--p2", nullptr);
     bc.eval_cmd = get_str("-e", "--eval", nullptr);
+    for (auto v = consume("--engine"); v; v = consume("--engine")) {
+        if (v->empty()) throw std::runtime_error("--engine needs a command");
+        bc.engines.push_back(*v);
+    }
+    if (auto v = consume("--tournament"); v && !v->empty()) {
+        if (*v == "gauntlet") bc.tournament = Core::Tournament::GAUNTLET;
+        else if (*v == "round-robin") bc.tournament = Core::Tournament::ROUND_ROBIN;
+        else throw std::runtime_error("--tournament must be gauntlet or round-robin");
+    }
+    if (!bc.engines.empty() || bc.tournament != Core::Tournament::NONE) {
+        if (!bc.p2_cmd.empty()) bc.engines.insert(bc.engines.begin(), bc.p2_cmd);
+        if (!bc.p1_cmd.empty()) bc.engines.insert(bc.engines.begin(), bc.p1_cmd);
+        if (bc.tournament == Core::Tournament::NONE)
+            bc.tournament = Core::Tournament::ROUND_ROBIN;
+        if (bc.engines.size() >= 2) {
+            bc.p1_cmd = bc.engines[0];
+            bc.p2_cmd = bc.engines[1];
+        }
+    }
     bc.board_size = get_int("-s", "--size", "SIZE", Core::Constants::DEFAULT_BOARD_SIZE);
+    if (auto v = consume("--rule"); v && !v->empty()) bc.rule = Game::Rules::parse(*v);
     bc.openings_path = get_str("-o", "--openings", "OPENINGS");
     bc.shuffle_openings = consume_flag("--shuffle-openings");
     bc.threads = get_int("-j", "--threads", "THREADS", -1);
+    bc.concurrency = get_int("", "--concurrency", "CONCURRENCY", 0);
 
     int common_announce = get_dur(
         "-t", "--timeout-announce", "TIMEOUT_ANNOUNCE", Core::Constants::DEFAULT_TIMEOUT_TURN_MS
@@ -209,7 +276,22 @@ Core::BatchConfig CLI::parse_batch_args(int argc, char* argv[]) {
             : Core::Constants::DEFAULT_RISK;
     }();
 
+    if (auto v = consume_signed("--sprt"); v && !v->empty()) {
+        auto bounds = Core::Utils::split_csv(*v);
+        if (bounds.size() != 2) throw std::runtime_error("--sprt expects <elo0>,<elo1>");
+        bc.sprt.enabled = true;
+        bc.sprt.elo0 = std::stod(bounds[0]);
+        bc.sprt.elo1 = std::stod(bounds[1]);
+    }
+    if (auto v = consume("--sprt-alpha"); v && !v->empty()) bc.sprt.alpha = std::stod(*v);
+    if (auto v = consume("--sprt-beta"); v && !v->empty()) bc.sprt.beta = std::stod(*v);
+
     bc.repeat = get_int("", "--repeat", nullptr, 1);
+    bc.adaptive = consume_flag("--adaptive");
+    bc.budget = get_int("", "--budget", nullptr, 0);
+    if (auto v = consume("--tune"); v && !v->empty()) bc.tune_path = *v;
+    if (auto v = consume("--tune-checkpoint"); v && !v->empty()) bc.tune_checkpoint = *v;
+    if (!bc.tune_path.empty() && bc.p2_cmd.empty()) bc.p2_cmd = bc.p1_cmd;
     if (auto v = consume("--seed"); v && !v->empty()) {
         for (const auto& i : Core::Utils::split_csv(*v)) bc.seeds.push_back(std::stoull(i));
     }
@@ -218,6 +300,25 @@ Core::BatchConfig CLI::parse_batch_args(int argc, char* argv[]) {
     bc.show_board = consume_flag("-b") || consume_flag("--show-board");
     bc.cleanup = consume_flag("--cleanup");
     bc.exit_on_crash = consume_flag("--exit-on-crash");
+    if (auto v = consume("--cgroup"); v && !v->empty()) bc.cgroup = *v;
+    if (auto v = consume("--cgroup-cpus"); v && !v->empty()) bc.cgroup_cpus = std::stod(*v);
+    if (auto v = consume("--cgroup-cpuset"); v && !v->empty()) bc.cgroup_cpuset = *v;
+    bc.reuse_engines = consume_flag("--reuse-engines");
+    bc.prespawn = get_int("", "--prespawn", nullptr, 0);
+    bc.pin = consume_flag("--pin");
+    bc.oversubscribe = consume_flag("--oversubscribe");
+    bc.eval_procs = get_int("", "--eval-procs", nullptr, 0);
+    bc.eval_queue = get_int("", "--eval-queue", nullptr, Core::Constants::EVAL_QUEUE_MAX);
+    bc.eval_idle_ms = get_dur(
+        "", "--eval-idle", nullptr, Core::Constants::EVAL_IDLE_SHUTDOWN_MS
+    );
+    bc.eval_whole_game = consume_flag("--eval-game");
+    if (auto v = consume("--eval-cache"); v && !v->empty()) bc.eval_cache = *v;
+    if (auto v = consume("--eval-cache-size"); v && !v->empty())
+        bc.eval_cache_size = (size_t)Core::Utils::parse_node_count(*v);
+    if (auto v = consume("--eval-cpus"); v && !v->empty()) {
+        for (const auto& i : Core::Utils::split_csv(*v)) bc.eval_cpus.push_back(std::stoi(i));
+    }
     bc.api_url = get_str("", "--api-url", "API_URL");
     bc.api_key = get_str("", "--api-key", "API_KEY");
     bc.debounce_ms = get_dur(
@@ -225,7 +326,12 @@ Core::BatchConfig CLI::parse_batch_args(int argc, char* argv[]) {
     );
     if (auto v = consume("--export-results");
     v && !v->empty()) bc.export_results = *v;
+    if (auto v = consume("--journal"); v && !v->empty()) bc.journal = *v;
+    bc.resume = consume_flag("--resume");
 
+    if (bc.tournament != Core::Tournament::NONE && bc.engines.size() < 2) {
+        throw std::runtime_error("A tournament needs at least two engines");
+    }
     if (bc.p1_cmd.empty() || bc.p2_cmd.empty()) {
         throw std::runtime_error("Missing -1/--p1 or -2/--p2");
     }
@@ -233,15 +339,78 @@ Core::BatchConfig CLI::parse_batch_args(int argc, char* argv[]) {
     if (!bc.api_url.empty() != !bc.api_key.empty()) {
         throw std::runtime_error("API URL and API Key must be provided together");
     }
-    if (bc.board_size < 5 || bc.board_size > 40) {
+    if (bc.board_size < Core::Constants::MIN_BOARD_SIZE ||
+        bc.board_size > Core::Constants::MAX_BOARD_SIZE) {
         throw std::runtime_error("Board size must be between 5 and 40");
     }
+    if (bc.cgroup_cpus < 0) {
+        throw std::runtime_error("--cgroup-cpus must be >= 0");
+    }
+    if (bc.cgroup.empty() && (bc.cgroup_cpus > 0 || !bc.cgroup_cpuset.empty())) {
+        throw std::runtime_error("--cgroup-cpus and --cgroup-cpuset need --cgroup");
+    }
+    if (bc.oversubscribe && !bc.pin) {
+        throw std::runtime_error("--oversubscribe needs --pin");
+    }
+    if (bc.budget < 0) {
+        throw std::runtime_error("--budget must be >= 0");
+    }
+    if (bc.budget > 0 && !bc.adaptive) {
+        throw std::runtime_error("--budget needs --adaptive");
+    }
+    if (bc.resume && bc.journal.empty()) {
+        throw std::runtime_error("--resume needs --journal");
+    }
+    if (!bc.journal.empty() && !bc.tune_path.empty()) {
+        throw std::runtime_error(
+            "--journal cannot be combined with --tune; use --tune-checkpoint"
+        );
+    }
+    if (!bc.tune_checkpoint.empty() && bc.tune_path.empty()) {
+        throw std::runtime_error("--tune-checkpoint needs --tune");
+    }
+    if (!bc.tune_path.empty()) {
+        if (bc.tournament != Core::Tournament::NONE || bc.sprt.enabled || bc.adaptive)
+            throw std::runtime_error(
+                "--tune cannot be combined with tournaments, --sprt or --adaptive"
+            );
+        auto multi = [](const auto& list) { return list.size() > 1; };
+        if (bc.repeat > 1 || multi(bc.common_nodes_list) || multi(bc.p1_nodes_list) ||
+            multi(bc.p2_nodes_list) || multi(bc.eval_nodes_list) ||
+            multi(bc.min_pairs_list) || multi(bc.max_pairs_list) || multi(bc.seeds))
+            throw std::runtime_error("--tune runs a single configuration, not a batch");
+    }
+    if (bc.prespawn < 0) {
+        throw std::runtime_error("--prespawn must be >= 0");
+    }
+    if (bc.eval_queue < 1) {
+        throw std::runtime_error("--eval-queue must be >= 1");
+    }
+    for (int c : bc.eval_cpus) {
+        if (c < 0) throw std::runtime_error("--eval-cpus entries must be >= 0");
+    }
+    if (bc.eval_cache_size < Core::Constants::CACHE_BUCKET_WAYS) {
+        throw std::runtime_error("--eval-cache-size must be >= 4");
+    }
+    if (!bc.eval_cache.empty() && bc.eval_nodes_list.size() > 1) {
+        throw std::runtime_error("--eval-cache needs a single evaluator node budget");
+    }
     for (int mp : bc.max_pairs_list) {
         if (mp < 1) throw std::runtime_error("--max-pairs must be >= 1");
     }
     if (bc.risk < 0.0 || bc.risk > 1.0) {
         throw std::runtime_error("--risk must be between 0.0 and 1.0");
     }
+    if (bc.sprt.enabled && bc.sprt.elo1 <= bc.sprt.elo0) {
+        throw std::runtime_error("--sprt needs elo1 > elo0");
+    }
+    if (bc.sprt.alpha <= 0.0 || bc.sprt.alpha >= 0.5 ||
+        bc.sprt.beta <= 0.0 || bc.sprt.beta >= 0.5) {
+        throw std::runtime_error("--sprt-alpha and --sprt-beta must be between 0 and 0.5");
+    }
+    if (bc.sprt.enabled && bc.risk > 0.0) {
+        throw std::runtime_error("--risk and --sprt are mutually exclusive");
+    }
     while (!bc.api_url.empty() && bc.api_url.back() == '/') {
         bc.api_url.pop_back();
     }
@@ -272,6 +441,8 @@ Core::BatchConfig CLI::parse_batch_args(int argc, char* argv[]) {
             bc.threads = std::max(1, hw / 2 - 1);
         }
     }
+    if (bc.concurrency <= 0) bc.concurrency = bc.threads;
+    if (bc.eval_procs <= 0) bc.eval_procs = bc.threads;
 
     return bc;
 }
@@ -285,13 +456,27 @@ std::vector<Core::RunSpec> CLI::expand_batch(const Core::BatchConfig& bc) {
     bool use_common = !bc.common_nodes_list.empty()
         && bc.p1_nodes_list.empty() && bc.p2_nodes_list.empty();
 
+    std::vector<std::pair<int, int>> pairings;
+    int engines = (int)bc.engines.size();
+    if (bc.tournament == Core::Tournament::GAUNTLET) {
+        for (int j = 1; j < engines; ++j) pairings.push_back({0, j});
+    } else if (bc.tournament == Core::Tournament::ROUND_ROBIN) {
+        for (int i = 0; i < engines; ++i)
+            for (int j = i + 1; j < engines; ++j) pairings.push_back({i, j});
+    } else {
+        pairings.push_back({0, 1});
+    }
+
     auto add_run = [&](uint64_t n1, uint64_t n2, uint64_t ne, int minp, int maxp, int r) {
-        Core::RunSpec rs;
-        rs.p1_nodes = n1; rs.p2_nodes = n2; rs.eval_nodes = ne;
-        rs.min_pairs = std::min(minp, maxp); rs.max_pairs = maxp;
-        rs.repeat_index = r;
-        if (r < (int)bc.seeds.size()) rs.seed = bc.seeds[r];
-        runs.push_back(rs);
+        for (const auto& [e1, e2] : pairings) {
+            Core::RunSpec rs;
+            rs.p1_nodes = n1; rs.p2_nodes = n2; rs.eval_nodes = ne;
+            rs.min_pairs = std::min(minp, maxp); rs.max_pairs = maxp;
+            rs.repeat_index = r;
+            rs.p1_engine = e1; rs.p2_engine = e2;
+            if (r < (int)bc.seeds.size()) rs.seed = bc.seeds[r];
+            runs.push_back(rs);
+        }
     };
 
     if (use_common) {
@@ -324,17 +509,20 @@ std::vector<Core::RunSpec> CLI::expand_batch(const Core::BatchConfig& bc) {
 
 Core::Config CLI::build_config(const Core::BatchConfig& bc, const Core::RunSpec& rs) {
     Core::Config cfg;
-    cfg.bot1.cmd = bc.p1_cmd;
-    cfg.bot2.cmd = bc.p2_cmd;
+    cfg.bot1.cmd = bc.engine_cmd(rs.p1_engine);
+    cfg.bot2.cmd = bc.engine_cmd(rs.p2_engine);
     cfg.eval_path = bc.eval_cmd;
     cfg.board_size = bc.board_size;
+    cfg.rule = bc.rule;
     cfg.openings_path = bc.openings_path;
     cfg.use_openings = !bc.openings_path.empty();
     cfg.shuffle_openings = bc.shuffle_openings;
     cfg.threads = bc.threads;
+    cfg.concurrency = bc.concurrency;
     cfg.max_pairs = rs.max_pairs;
     cfg.min_pairs = rs.min_pairs;
     cfg.risk = bc.risk;
+    cfg.sprt = bc.sprt;
     cfg.debug = bc.debug;
     cfg.show_board = bc.show_board;
     cfg.cleanup = bc.cleanup;
@@ -418,12 +606,18 @@ std::deque<GameParams> CLI::create_pending_games(
                 }
             }
         }
-        pending_games.push_back(
-            {i + 1, 0, cfg.bot1, cfg.bot2, op, seed, context, run_id, nullptr}
-        );
-        pending_games.push_back(
-            {i + 1, 1, cfg.bot2, cfg.bot1, op, seed, context, run_id, nullptr}
-        );
+        for (int leg = 0; leg < 2; ++leg) {
+            GameParams g;
+            g.pair = i + 1;
+            g.leg = leg;
+            g.p1_cfg = leg == 0 ? cfg.bot1 : cfg.bot2;
+            g.p2_cfg = leg == 0 ? cfg.bot2 : cfg.bot1;
+            g.opening = op;
+            g.seed = seed;
+            g.context = context;
+            g.run_id = run_id;
+            pending_games.push_back(std::move(g));
+        }
     }
     return pending_games;
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <string>
 #include <vector>
 #include <map>
@@ -11,42 +14,66 @@
 #include <functional>
 #include "../core/config_types.h"
 #include "../core/types.h"
+#include "../core/game_record.h"
 #include "../stats/tracker.h"
+#include "../sys/affinity.h"
+#include "../sys/cgroup.h"
 #include "../sys/cpu_monitor.h"
 #include "../sys/process.h"
+#include "../sys/process_pool.h"
 
 namespace Arena::App {
 
+    class Tuner;
+    class Journal;
+
     struct MatchState {
         std::map<int, std::pair<double, double>> results;
         std::mutex mtx;
         std::condition_variable cv;
         int pairs_done = 0, wins = 0, losses = 0, draws = 0;
+        std::array<int, 5> penta{};
+
+        void record_pair(double first, double second) {
+            pairs_done++;
+            if (first < 0 || second < 0) return;
+            double total_score = first + (1.0 - second);
+            if (total_score > 1.0) wins++;
+            else if (total_score < 1.0) losses++;
+            else draws++;
+            penta[std::clamp((int)std::lround(total_score * 2.0), 0, 4)]++;
+        }
     };
 
     struct RunContext {
-        RunContext() { last_api_update = std::chrono::steady_clock::now(); }
+        RunContext() {
+            last_api_update = last_progress_log = std::chrono::steady_clock::now();
+        }
 
         std::string id, config_label;
         Core::Config cfg;
         Core::RunSpec run_spec;
         Stats::Tracker stats;
         MatchState match_state;
+        std::shared_ptr<Tuner> tuner;
+        std::shared_ptr<Journal> journal;
+        std::string journal_key;
 
         std::atomic<long long> total_wall_time_ms{0};
-        std::atomic<long long> total_p1_cpu{0}, total_p2_cpu{0};
-        std::atomic<long long> total_p1_wall{0}, total_p2_wall{0};
+        std::atomic<long long> total_p1_cpu_ns{0}, total_p2_cpu_ns{0};
+        std::atomic<long long> total_p1_wall_ns{0}, total_p2_wall_ns{0};
 
         std::chrono::steady_clock::time_point run_start;
-        Sys::CpuMonitor::Times run_start_cpu;
+        long long run_start_cpu_ns = 0;
 
         std::atomic<int> games_completed{0}, games_skipped{0};
+        std::atomic<int> evals_pending{0};
         int total_games_expected = 0;
 
         std::atomic<bool> stop_flag{false};
         std::once_flag finalized_flag;
 
-        std::chrono::steady_clock::time_point last_api_update;
+        std::chrono::steady_clock::time_point last_api_update, last_progress_log;
         std::mutex api_mtx;
 
         std::string p1_name, p1_version, p2_name, p2_version;
@@ -65,6 +92,27 @@ namespace Arena::App {
             }
             return false;
         }
+
+        bool should_log_progress() {
+            std::lock_guard<std::mutex> l(api_mtx);
+            auto now = std::chrono::steady_clock::now();
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                now - last_progress_log
+            ).count();
+            if (elapsed >= Core::Constants::PROGRESS_LOG_INTERVAL_MS) {
+                last_progress_log = now;
+                return true;
+            }
+            return false;
+        }
+    };
+
+    struct GameTally {
+        int pair = 0, leg = 0;
+        double p1_score = 0;
+        long wall_ms = 0;
+        Stats::Tracker stats;
+        std::atomic<int> pending{1};
     };
 
     struct GameParams {
@@ -74,6 +122,10 @@ namespace Arena::App {
         std::optional<uint64_t> seed;
         std::shared_ptr<RunContext> context;
         std::string run_id;
+        std::shared_ptr<Sys::ProcessPool> pool;
+        Sys::Reactor* reactor = nullptr;
+        std::shared_ptr<Sys::CoreAllocator::Lease> cores;
+        std::shared_ptr<GameTally> tally;
 
         std::function<std::unique_ptr<Sys::Process>(
             const std::string&
@@ -84,13 +136,38 @@ namespace Arena::App {
             return nullptr;
         }
 
+        long long spawn_memory(const Core::BotConfig& cfg) const {
+            long long mem = cfg.memory;
+            if (mem > 0 && Core::is_rapfi_bot(cfg.cmd) && !Sys::Cgroup::enabled())
+                mem += Core::Constants::PROCESS_MEMORY_OVERHEAD;
+            return mem;
+        }
+
+        std::map<std::string, std::string> spawn_env() const {
+            std::map<std::string, std::string> env_vars;
+            if (seed) env_vars["GOMOKU_SEED"] = std::to_string(*seed);
+            return env_vars;
+        }
+
+        std::string pool_key(const Core::BotConfig& cfg) const {
+            return cfg.cmd + "|" + std::to_string(cfg.memory) + "|" +
+                std::to_string(config().board_size) + "|" +
+                (seed ? std::to_string(*seed) : std::string("-"));
+        }
+
         const Core::Config& config() const { return context->cfg; }
     };
 
     struct EvalJob {
-        std::vector<Core::Point> moves;
+        Core::MoveList moves;
         int bot_id;
         std::shared_ptr<RunContext> context;
         uint64_t max_nodes;
+        uint64_t game = 0;
+        bool whole_game = false;
+        size_t opening = 0;
+        std::chrono::steady_clock::time_point queued{};
+        std::vector<uint64_t> keys{};
+        std::shared_ptr<GameTally> tally{};
     };
 }
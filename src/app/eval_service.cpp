@@ -0,0 +1,388 @@
+#include "eval_service.h"
+#include "journal.h"
+#include "../analysis/cache.h"
+#include "../core/logger.h"
+#include "../sys/affinity.h"
+#include "../sys/cpu_monitor.h"
+#include "../sys/signals.h"
+#include <algorithm>
+#include <iomanip>
+
+namespace Arena::App {
+
+EvalService::EvalService(Options o) : opt_(std::move(o)) {
+    if (opt_.procs < 1) opt_.procs = 1;
+    if (opt_.queue_max < 1) opt_.queue_max = 1;
+    load_.assign(opt_.procs, 0);
+}
+
+EvalService::~EvalService() { stop(); }
+
+void EvalService::start() {
+    for (int i = 0; i < opt_.procs; ++i)
+        threads_.emplace_back([this, i]() { loop(i); });
+}
+
+void EvalService::stop() {
+    {
+        std::lock_guard<std::mutex> l(mtx_);
+        stopping_ = true;
+    }
+    job_cv_.notify_all();
+    space_cv_.notify_all();
+    for (auto& t : threads_) if (t.joinable()) t.join();
+    threads_.clear();
+}
+
+void EvalService::drain() {
+    std::unique_lock<std::mutex> l(mtx_);
+    while (!stopping_ && !Sys::g_stop_flag && (!queue_.empty() || in_flight_ > 0)) {
+        idle_cv_.wait_for(l, std::chrono::milliseconds(
+            Core::Constants::WORKER_IDLE_WAIT_MS
+        ));
+    }
+}
+
+bool EvalService::submit(EvalJob job, bool wait) {
+    std::unique_lock<std::mutex> l(mtx_);
+    while (wait && !stopping_ && !Sys::g_stop_flag && queue_.size() >= opt_.queue_max) {
+        space_cv_.wait_for(l, std::chrono::milliseconds(
+            Core::Constants::WORKER_IDLE_WAIT_MS
+        ));
+    }
+    if (stopping_ || Sys::g_stop_flag) return false;
+    job.queued = std::chrono::steady_clock::now();
+    if (job.game && !owners_.count(job.game)) {
+        int best = (int)(std::min_element(load_.begin(), load_.end()) - load_.begin());
+        owners_[job.game] = best;
+        load_[best]++;
+    }
+    if (job.context) job.context->evals_pending++;
+    if (job.tally) job.tally->pending++;
+    queue_.push_back(std::move(job));
+    job_cv_.notify_all();
+    return true;
+}
+
+bool EvalService::saturated() const {
+    std::lock_guard<std::mutex> l(mtx_);
+    return queue_.size() >= opt_.queue_max;
+}
+
+size_t EvalService::pending() const {
+    std::lock_guard<std::mutex> l(mtx_);
+    return queue_.size() + in_flight_;
+}
+
+EvalService::Stats EvalService::stats() const {
+    std::lock_guard<std::mutex> l(mtx_);
+    return stats_;
+}
+
+std::unique_ptr<Analysis::Evaluator> EvalService::spawn(
+    int index, std::shared_ptr<Sys::CoreAllocator::Lease>& cores
+) {
+    auto eval = std::make_unique<Analysis::Evaluator>(
+        opt_.cmd, opt_.board_size, opt_.timeout_cutoff,
+        opt_.exit_on_crash, opt_.max_nodes,
+        opt_.process_factory ? opt_.process_factory(opt_.cmd) : nullptr
+    );
+    eval->set_rule(opt_.rule);
+    if (!eval->start()) return nullptr;
+
+    std::vector<int> cpus;
+    if (!opt_.cpus.empty()) {
+        cpus = {opt_.cpus[index % opt_.cpus.size()]};
+    } else if (opt_.cores && (cores = opt_.cores->acquire(1))) {
+        cpus = cores->cpus(0);
+    }
+    if (!cpus.empty() && !Sys::Affinity::pin_process(eval->pid(), cpus)) {
+        Core::Logger::log(
+            Core::Logger::Level::WARN,
+            "Evaluator ", index, ": failed to pin to CPU ", cpus.front()
+        );
+    }
+
+    std::lock_guard<std::mutex> l(mtx_);
+    stats_.spawns++;
+    return eval;
+}
+
+void EvalService::loop(int index) {
+    std::unique_ptr<Analysis::Evaluator> eval;
+    std::shared_ptr<Sys::CoreAllocator::Lease> cores;
+    bool spawn_failed = false;
+
+    while (true) {
+        std::vector<EvalJob> batch;
+        {
+            std::unique_lock<std::mutex> l(mtx_);
+            auto idle_until = std::chrono::steady_clock::now() +
+                std::chrono::milliseconds(opt_.idle_ms);
+            bool ready = false;
+            while (!stopping_ && !Sys::g_stop_flag) {
+                auto now = std::chrono::steady_clock::now();
+                if (next_job(index, now) != queue_.end()) { ready = true; break; }
+                if (queue_.empty() && now >= idle_until) break;
+                auto until = queue_.empty() ? idle_until : std::min(idle_until,
+                    now + std::chrono::milliseconds(Core::Constants::EVAL_STEAL_MS));
+                job_cv_.wait_until(l, until);
+            }
+            if (stopping_ || Sys::g_stop_flag) break;
+            if (!ready) {
+                if (eval) {
+                    stats_.idle_shutdowns++;
+                    l.unlock();
+                    eval.reset();
+                    cores.reset();
+                    Core::Logger::log(
+                        Core::Logger::Level::DEBUG,
+                        "Evaluator ", index, " idle, shutting down"
+                    );
+                }
+                continue;
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            while (batch.size() < Core::Constants::EVAL_BATCH_MAX) {
+                auto it = next_job(index, now);
+                if (it == queue_.end()) break;
+                wait_.add_since(it->queued);
+                batch.push_back(std::move(*it));
+                queue_.erase(it);
+            }
+            in_flight_ += (int)batch.size();
+        }
+        space_cv_.notify_all();
+
+        bool terminated = false;
+        uint64_t full = 0, delta = 0;
+        try {
+            if (!eval && !spawn_failed) {
+                eval = spawn(index, cores);
+                spawn_failed = !eval;
+            }
+            if (eval) {
+                full = eval->full_syncs();
+                delta = eval->delta_syncs();
+            }
+            for (auto& job : batch) process(eval.get(), job);
+            if (eval) {
+                full = eval->full_syncs() - full;
+                delta = eval->delta_syncs() - delta;
+            }
+        } catch (const Core::MatchTerminated&) {
+            terminated = true;
+        } catch (const std::exception& e) {
+            Core::Logger::log(
+                Core::Logger::Level::ERROR,
+                "Evaluator ", index, " exception: ", e.what()
+            );
+            if (!eval) spawn_failed = true;
+            eval.reset();
+            cores.reset();
+            full = delta = 0;
+        }
+
+        for (auto& job : batch) {
+            if (job.context) settle_game(*job.context, job.tally);
+            if (job.context && --job.context->evals_pending == 0 && opt_.on_drained)
+                opt_.on_drained(job.context);
+        }
+        {
+            std::lock_guard<std::mutex> l(mtx_);
+            in_flight_ -= (int)batch.size();
+            stats_.jobs += batch.size();
+            stats_.full_syncs += full;
+            stats_.delta_syncs += delta;
+        }
+        idle_cv_.notify_all();
+        if (terminated) break;
+    }
+}
+
+int EvalService::owner(uint64_t game) const {
+    auto it = owners_.find(game);
+    return it == owners_.end() ? -1 : it->second;
+}
+
+void EvalService::end_game(uint64_t game) {
+    std::lock_guard<std::mutex> l(mtx_);
+    auto it = owners_.find(game);
+    if (it == owners_.end()) return;
+    load_[it->second]--;
+    owners_.erase(it);
+}
+
+std::deque<EvalJob>::iterator EvalService::next_job(
+    int index, std::chrono::steady_clock::time_point now
+) {
+    auto steal = std::chrono::milliseconds(Core::Constants::EVAL_STEAL_MS);
+    auto stolen = queue_.end();
+    size_t scan = std::min(queue_.size(), Core::Constants::EVAL_AFFINITY_SCAN);
+    for (size_t i = 0; i < scan; ++i) {
+        auto it = queue_.begin() + i;
+        int o = owner(it->game);
+        if (o == index) return it;
+        if (stolen == queue_.end() && (o < 0 || now - it->queued >= steal)) stolen = it;
+    }
+    if (stolen == queue_.end() && queue_.size() > scan) stolen = queue_.begin();
+    return stolen;
+}
+
+void EvalService::process_game(Analysis::Evaluator* eval, EvalJob& job) {
+    size_t n = job.moves.size();
+    size_t first = job.opening + 1;
+    if (first > n) return;
+    int board_size = job.context->cfg.board_size;
+
+    std::vector<uint64_t> keys;
+    if (job.keys.size() >= n - job.opening) {
+        keys.assign(job.keys.end() - (n - job.opening), job.keys.end());
+    } else {
+        Analysis::SymmetricHash sym(board_size);
+        for (size_t ply = 1; ply < first; ++ply) sym.push(job.moves[ply - 1]);
+        for (size_t ply = first; ply <= n; ++ply) {
+            keys.push_back(sym.key(job.moves[ply - 1]));
+            sym.push(job.moves[ply - 1]);
+        }
+    }
+
+    bool all_cached = true;
+    for (size_t i = 0; i < keys.size() && all_cached; ++i)
+        all_cached = Analysis::GlobalCache::contains(keys[i], job.max_nodes);
+
+    std::optional<std::vector<Arena::Stats::EvalMetrics>> res;
+    if (!all_cached && eval) {
+        eval->set_max_nodes(job.max_nodes);
+        res = eval->eval_game(job.moves, first);
+        if (res) {
+            std::lock_guard<std::mutex> l(mtx_);
+            stats_.whole_games++;
+        }
+    }
+
+    for (size_t ply = first; ply <= n; ++ply) {
+        EvalJob sub{
+            job.moves.prefix(ply),
+            (n - ply) % 2 == 0 ? job.bot_id : 3 - job.bot_id,
+            job.context, job.max_nodes, job.game
+        };
+        sub.keys = {keys[ply - first]};
+        sub.tally = job.tally;
+        if (!res) {
+            process(eval, sub);
+            continue;
+        }
+        Analysis::GlobalCache::set(keys[ply - first], (*res)[ply], job.max_nodes);
+        record(sub, (*res)[ply]);
+    }
+}
+
+void EvalService::process(Analysis::Evaluator* eval, EvalJob& job) {
+    if (job.whole_game) {
+        process_game(eval, job);
+        return;
+    }
+
+    bool debug = job.context->cfg.debug;
+    int board_size = job.context->cfg.board_size;
+
+    uint64_t h = job.keys.empty()
+        ? Analysis::GlobalCache::hash(job.moves, board_size)
+        : job.keys.back();
+    auto cached = Analysis::GlobalCache::get(h, job.max_nodes);
+
+    Arena::Stats::EvalMetrics m;
+
+    if (cached) {
+        m = *cached;
+        {
+            std::lock_guard<std::mutex> l(mtx_);
+            stats_.cache_hits++;
+        }
+        if (debug) {
+            Core::Logger::log(
+                Core::Logger::Level::DEBUG,
+                "[CACHE HIT] Move ", job.moves.size(), " hash=", h
+            );
+        }
+    } else {
+        if (!eval) return;
+
+        if (debug) {
+            Core::Logger::log(
+                Core::Logger::Level::DEBUG,
+                "[CACHE MISS] Move ", job.moves.size(), " hash=", h
+            );
+        }
+
+        long long cpu_start = debug ? eval->cpu_ns() : 0;
+
+        auto t0 = std::chrono::steady_clock::now();
+        eval->set_max_nodes(job.max_nodes);
+        m = eval->eval(job.moves);
+        auto t1 = std::chrono::steady_clock::now();
+
+        Analysis::GlobalCache::set(h, m, job.max_nodes);
+
+        if (debug) {
+            long long wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                t1 - t0
+            ).count();
+            long long cpu_ns = std::max(0LL, eval->cpu_ns() - cpu_start);
+            double load = Sys::CpuMonitor::calculate_load(cpu_ns, wall_ns);
+            Core::Logger::log(
+                Core::Logger::Level::DEBUG,
+                "Eval Move ", job.moves.size(), " | Wall: ", std::fixed,
+                std::setprecision(3), wall_ns / 1e6, "ms | CPU: ", cpu_ns / 1e6,
+                "ms | Load: ", (int)load, "%"
+            );
+        }
+    }
+
+    record(job, m);
+}
+
+void EvalService::record(const EvalJob& job, const Arena::Stats::EvalMetrics& m) {
+    bool debug = job.context->cfg.debug;
+
+    if (m.p_best < Core::Constants::GARBAGE_TIME_PROB_THRESHOLD) {
+        if (debug) {
+            Core::Logger::log(
+                Core::Logger::Level::DEBUG,
+                "Move ", job.moves.size(), " SKIPPED (Garbage Time p_best=",
+                std::fixed, std::setprecision(3), m.p_best, ")"
+            );
+        }
+        return;
+    }
+
+    double regret = std::max(0.0, m.p_best - m.p_played);
+    double sharpness = std::max(0.0, m.p_best - m.p_second);
+
+    if (debug) {
+        Core::Logger::log(
+            Core::Logger::Level::DEBUG,
+            "Move ", job.moves.size(), " P", job.bot_id,
+            " | p_best=", std::fixed, std::setprecision(4), m.p_best,
+            " p_second=", m.p_second,
+            " p_played=", m.p_played,
+            " | Regret=", regret, " Sharpness=", sharpness
+        );
+    }
+
+    if (regret > Core::Constants::METRIC_SEVERE_ERROR_REGRET) {
+        Core::Logger::log(
+            Core::Logger::Level::DEBUG,
+            "BLUNDER: Move ", job.moves.size(), " P", job.bot_id,
+            " Regret=", std::fixed, std::setprecision(3), regret,
+            " (played=", m.p_played, " vs best=", m.p_best, ")"
+        );
+    }
+
+    job.context->stats.add_metrics(job.bot_id, regret, sharpness);
+    if (job.tally) job.tally->stats.add_metrics(job.bot_id, regret, sharpness);
+}
+
+}
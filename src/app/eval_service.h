@@ -0,0 +1,88 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include "context.h"
+#include "../analysis/evaluator.h"
+#include "../stats/queue_wait.h"
+
+namespace Arena::App {
+
+    class EvalService {
+    public:
+        struct Options {
+            std::string cmd;
+            int board_size = Core::Constants::DEFAULT_BOARD_SIZE;
+            Core::Rule rule = Core::Rule::FREESTYLE;
+            int timeout_cutoff = Core::Constants::DEFAULT_EVAL_CUTOFF_MS;
+            bool exit_on_crash = false;
+            uint64_t max_nodes = Core::Constants::DEFAULT_EVAL_NODES;
+            int procs = 1;
+            size_t queue_max = Core::Constants::EVAL_QUEUE_MAX;
+            int idle_ms = Core::Constants::EVAL_IDLE_SHUTDOWN_MS;
+            std::vector<int> cpus;
+            std::shared_ptr<Sys::CoreAllocator> cores;
+            std::function<std::unique_ptr<Sys::Process>(
+                const std::string&
+            )> process_factory;
+            std::function<void(const std::shared_ptr<RunContext>&)> on_drained;
+        };
+
+        struct Stats {
+            uint64_t jobs = 0;
+            uint64_t cache_hits = 0;
+            uint64_t spawns = 0;
+            uint64_t idle_shutdowns = 0;
+            uint64_t full_syncs = 0;
+            uint64_t delta_syncs = 0;
+            uint64_t whole_games = 0;
+        };
+
+        explicit EvalService(Options o);
+        ~EvalService();
+        EvalService(const EvalService&) = delete;
+        EvalService& operator=(const EvalService&) = delete;
+
+        void start();
+        void stop();
+        void drain();
+        bool submit(EvalJob job, bool wait = true);
+        void end_game(uint64_t game);
+        bool saturated() const;
+        size_t pending() const;
+        Stats stats() const;
+        const Arena::Stats::QueueWait& queue_wait() const { return wait_; }
+
+    private:
+        void loop(int index);
+        int owner(uint64_t game) const;
+        std::deque<EvalJob>::iterator next_job(
+            int index, std::chrono::steady_clock::time_point now
+        );
+        std::unique_ptr<Analysis::Evaluator> spawn(
+            int index, std::shared_ptr<Sys::CoreAllocator::Lease>& cores
+        );
+        void process(Analysis::Evaluator* eval, EvalJob& job);
+        void process_game(Analysis::Evaluator* eval, EvalJob& job);
+        void record(const EvalJob& job, const Arena::Stats::EvalMetrics& m);
+
+        Options opt_;
+        std::vector<std::thread> threads_;
+        std::deque<EvalJob> queue_;
+        mutable std::mutex mtx_;
+        std::condition_variable job_cv_, space_cv_, idle_cv_;
+        int in_flight_ = 0;
+        bool stopping_ = false;
+        Stats stats_;
+        Arena::Stats::QueueWait wait_;
+        std::unordered_map<uint64_t, int> owners_;
+        std::vector<int> load_;
+    };
+}
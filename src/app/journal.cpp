@@ -0,0 +1,214 @@
+#include "journal.h"
+#include "../sys/signals.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace Arena::App {
+
+    namespace {
+        constexpr const char* HEADER = "# arena journal seed ";
+
+        std::string fnv1a_hex(const std::string& s) {
+            uint64_t h = 1469598103934665603ULL;
+            for (unsigned char c : s) {
+                h ^= c;
+                h *= 1099511628211ULL;
+            }
+            std::ostringstream ss;
+            ss << std::hex << h;
+            return ss.str();
+        }
+    }
+
+    std::string Journal::key(const Core::RunSpec& rs) {
+        std::ostringstream ss;
+        ss << "e" << rs.p1_engine << "-" << rs.p2_engine
+           << "/n" << rs.p1_nodes << "-" << rs.p2_nodes << "-" << rs.eval_nodes
+           << "/p" << rs.min_pairs << "-" << rs.max_pairs
+           << "/r" << rs.repeat_index
+           << "/s" << (rs.seed ? std::to_string(*rs.seed) : std::string("-"));
+        return ss.str();
+    }
+
+    Journal::Journal(const std::string& path, const std::string& identity, bool resume)
+        : last_sync_(std::chrono::steady_clock::now())
+    {
+        std::string text;
+        int in = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (in >= 0) {
+            char buf[Core::Constants::READ_BUFFER_SIZE];
+            ssize_t n;
+            while ((n = read(in, buf, sizeof(buf))) > 0) text.append(buf, n);
+            close(in);
+        }
+        if (!text.empty() && !resume) {
+            throw std::runtime_error(
+                "Journal " + path + " already exists; pass --resume to continue it"
+            );
+        }
+
+        fd_ = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd_ < 0) {
+            throw std::runtime_error(
+                "Cannot open journal " + path + ": " + std::strerror(errno)
+            );
+        }
+
+        size_t end = text.rfind('\n');
+        end = end == std::string::npos ? 0 : end + 1;
+        if (end < text.size()) {
+            if (ftruncate(fd_, (off_t)end) != 0) {
+                throw std::runtime_error(
+                    "Cannot truncate journal " + path + ": " + std::strerror(errno)
+                );
+            }
+            fsync(fd_);
+            text.resize(end);
+        }
+
+        if (text.empty()) {
+            seed_ = std::random_device{}();
+            append(
+                HEADER + std::to_string(seed_) + " batch " + fnv1a_hex(identity) + "\n"
+            );
+            fsync(fd_);
+            return;
+        }
+        load(text);
+        if (batch_ != fnv1a_hex(identity)) {
+            close(fd_);
+            fd_ = -1;
+            throw std::runtime_error(
+                "Journal " + path + " was written for a different batch (engines, "
+                "board, rule, openings or time control changed); use a new journal"
+            );
+        }
+    }
+
+    Journal::~Journal() {
+        if (fd_ < 0) return;
+        fsync(fd_);
+        close(fd_);
+    }
+
+    void Journal::load(const std::string& text) {
+        size_t start = 0;
+        while (true) {
+            size_t end = text.find('\n', start);
+            if (end == std::string::npos) break;
+            std::string line = text.substr(start, end - start);
+            start = end + 1;
+
+            if (line.rfind(HEADER, 0) == 0) {
+                std::istringstream ss(line.substr(std::strlen(HEADER)));
+                std::string tag;
+                ss >> seed_ >> tag >> batch_;
+                continue;
+            }
+
+            std::istringstream ss(line);
+            std::string type, key;
+            if (!(ss >> type >> key)) continue;
+            if (type == "G") {
+                Game g;
+                if (!(ss >> g.pair >> g.leg >> g.p1_score >> g.wall_ms)) continue;
+                std::getline(ss >> std::ws, g.stats);
+                runs_[key].games.push_back(std::move(g));
+                loaded_++;
+            } else if (type == "F") {
+                auto& r = runs_[key];
+                r.finished = true;
+                std::getline(ss >> std::ws, r.stats);
+            }
+        }
+    }
+
+    bool Journal::finished(const std::string& key) const {
+        auto it = runs_.find(key);
+        return it != runs_.end() && it->second.finished;
+    }
+
+    int Journal::replay(const std::string& key, RunContext& ctx) const {
+        auto it = runs_.find(key);
+        if (it == runs_.end()) return 0;
+
+        int pairs = 0;
+        auto& ms = ctx.match_state;
+        std::lock_guard<std::mutex> l(ms.mtx);
+        for (const auto& g : it->second.games) {
+            auto [pos, added] = ms.results.try_emplace(
+                g.pair, Core::Constants::PAIR_RESULT_UNSET,
+                Core::Constants::PAIR_RESULT_UNSET
+            );
+            auto& res = pos->second;
+            double& slot = g.leg == 0 ? res.first : res.second;
+            if (slot > Core::Constants::PAIR_RESULT_THRESHOLD) continue;
+            slot = g.p1_score;
+
+            if (g.leg == 0) pairs++;
+            if (g.p1_score >= 0)
+                ctx.stats.update_elo(g.leg == 0 ? g.p1_score : (1.0 - g.p1_score));
+            Stats::Tracker t;
+            if (t.restore(g.stats)) ctx.stats.merge(t);
+            ctx.total_wall_time_ms += g.wall_ms;
+            ctx.games_completed++;
+            if (res.first > Core::Constants::PAIR_RESULT_THRESHOLD &&
+                res.second > Core::Constants::PAIR_RESULT_THRESHOLD)
+                ms.record_pair(res.first, res.second);
+        }
+
+        if (it->second.finished) ctx.stats.restore(it->second.stats);
+        return pairs;
+    }
+
+    void Journal::record_game(
+        const std::string& key, int pair, int leg, double p1_score,
+        long wall_ms, const Stats::Tracker& stats
+    ) {
+        std::lock_guard<std::mutex> l(mtx_);
+        std::ostringstream ss;
+        ss << "G " << key << " " << pair << " " << leg << " " << p1_score
+           << " " << wall_ms << " " << stats.snapshot() << "\n";
+        append(ss.str());
+    }
+
+    void Journal::record_finish(const std::string& key, const Stats::Tracker& stats) {
+        std::lock_guard<std::mutex> l(mtx_);
+        append("F " + key + " " + stats.snapshot() + "\n");
+    }
+
+    void Journal::append(const std::string& line) {
+        size_t off = 0;
+        while (off < line.size()) {
+            ssize_t n = write(fd_, line.data() + off, line.size() - off);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return;
+            off += (size_t)n;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (++unsynced_ >= Core::Constants::JOURNAL_SYNC_RECORDS ||
+            now - last_sync_ >= std::chrono::milliseconds(
+                Core::Constants::JOURNAL_SYNC_MS)) {
+            fdatasync(fd_);
+            unsynced_ = 0;
+            last_sync_ = now;
+        }
+    }
+
+    void settle_game(RunContext& ctx, const std::shared_ptr<GameTally>& tally) {
+        if (!tally || --tally->pending > 0) return;
+        if (ctx.journal && !Sys::g_stop_flag) {
+            ctx.journal->record_game(
+                ctx.journal_key, tally->pair, tally->leg, tally->p1_score,
+                tally->wall_ms, tally->stats
+            );
+        }
+    }
+}
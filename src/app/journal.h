@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "context.h"
+
+namespace Arena::App {
+
+    class Journal {
+    public:
+        struct Game {
+            int pair, leg;
+            double p1_score;
+            long wall_ms;
+            std::string stats;
+        };
+
+        struct Run {
+            std::vector<Game> games;
+            bool finished = false;
+            std::string stats;
+        };
+
+        static std::string key(const Core::RunSpec& rs);
+
+        Journal(const std::string& path, const std::string& identity, bool resume);
+        ~Journal();
+        Journal(const Journal&) = delete;
+        Journal& operator=(const Journal&) = delete;
+
+        uint64_t seed() const { return seed_; }
+        size_t loaded() const { return loaded_; }
+        bool finished(const std::string& key) const;
+        int replay(const std::string& key, RunContext& ctx) const;
+
+        void record_game(
+            const std::string& key, int pair, int leg, double p1_score,
+            long wall_ms, const Stats::Tracker& stats
+        );
+        void record_finish(const std::string& key, const Stats::Tracker& stats);
+
+    private:
+        void load(const std::string& text);
+        void append(const std::string& line);
+
+        int fd_ = -1;
+        uint64_t seed_ = 0;
+        std::string batch_;
+        size_t loaded_ = 0;
+        std::map<std::string, Run> runs_;
+
+        std::mutex mtx_;
+        int unsynced_ = 0;
+        std::chrono::steady_clock::time_point last_sync_;
+    };
+
+    void settle_game(RunContext& ctx, const std::shared_ptr<GameTally>& tally);
+}
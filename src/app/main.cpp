@@ -3,24 +3,121 @@
 #include <fstream>
 #include <thread>
 #include <deque>
+#include <algorithm>
 #include <vector>
+#include <map>
 #include <memory>
+#include <iomanip>
+#include <sstream>
+#include <random>
+#include <sys/stat.h>
 #include <curl/curl.h>
 
 #include "../core/constants.h"
 #include "../core/logger.h"
 #include "../sys/signals.h"
 #include "../sys/cpu_monitor.h"
+#include "../sys/affinity.h"
+#include "../sys/cgroup.h"
+#include "../sys/reactor.h"
+#include "../sys/process_pool.h"
 #include "../analysis/cache.h"
+#include "../stats/bradley_terry.h"
+#include "../stats/sprt.h"
 #include "../game/openings.h"
 #include "../net/api_client.h"
 #include "../core/utils.h"
 #include "cli.h"
 #include "context.h"
+#include "journal.h"
+#include "tuner.h"
 #include "worker.h"
 
 using namespace Arena;
 
+namespace {
+    std::string command_identity(const std::string& cmd) {
+        std::string exe = cmd.substr(0, cmd.find(' '));
+        struct stat st{};
+        if (stat(exe.c_str(), &st) != 0) return cmd;
+        return cmd + "|" + std::to_string(st.st_size) + "|" +
+            std::to_string((long long)st.st_mtime);
+    }
+
+    std::string batch_identity(const Core::BatchConfig& bc) {
+        std::ostringstream ss;
+        size_t engines = bc.engines.empty() ? 2 : bc.engines.size();
+        for (size_t i = 0; i < engines; ++i)
+            ss << command_identity(bc.engine_cmd((int)i)) << "\n";
+        ss << "size=" << bc.board_size << " rule=" << static_cast<int>(bc.rule)
+           << " openings=" << (bc.openings_path.empty()
+               ? std::string("-") : command_identity(bc.openings_path))
+           << " shuffle=" << bc.shuffle_openings
+           << " t=" << bc.p1_timeout_announce << "," << bc.p2_timeout_announce
+           << " T=" << bc.p1_timeout_cutoff << "," << bc.p2_timeout_cutoff
+           << " g=" << bc.p1_timeout_game << "," << bc.p2_timeout_game;
+        return ss.str();
+    }
+
+    void log_tournament(
+        const Core::BatchConfig& bc,
+        const std::vector<std::shared_ptr<App::RunContext>>& contexts
+    ) {
+        using Player = std::pair<int, uint64_t>;
+        std::map<Player, size_t> index;
+        for (const auto& ctx : contexts) {
+            index[{ctx->run_spec.p1_engine, ctx->cfg.bot1.max_nodes}];
+            index[{ctx->run_spec.p2_engine, ctx->cfg.bot2.max_nodes}];
+        }
+        std::vector<std::string> names;
+        std::map<int, int> configs;
+        for (const auto& [player, i] : index) configs[player.first]++;
+        for (auto& [player, i] : index) {
+            i = names.size();
+            std::string name = Core::Utils::command_name(bc.engines[player.first]);
+            if (configs[player.first] > 1 && player.second > 0)
+                name += " N=" + Core::Utils::format_nodes(player.second);
+            names.push_back(name);
+        }
+
+        Stats::BradleyTerry bt(names.size());
+        for (const auto& ctx : contexts) {
+            size_t e1 = index[{ctx->run_spec.p1_engine, ctx->cfg.bot1.max_nodes}];
+            size_t e2 = index[{ctx->run_spec.p2_engine, ctx->cfg.bot2.max_nodes}];
+            std::lock_guard<std::mutex> l(ctx->match_state.mtx);
+            for (const auto& [pair, res] : ctx->match_state.results) {
+                bt.add(e1, e2, res.first);
+                bt.add(e2, e1, res.second);
+            }
+        }
+
+        auto ratings = bt.fit();
+        std::vector<size_t> order(ratings.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return ratings[a].elo > ratings[b].elo;
+        });
+
+        Core::Logger::log(
+            Core::Logger::Level::INFO,
+            "Tournament ratings (Bradley-Terry, relative to ",
+            names[0], ", 95% error):"
+        );
+        for (size_t rank = 0; rank < order.size(); ++rank) {
+            const auto& r = ratings[order[rank]];
+            std::ostringstream ss;
+            ss << std::fixed << std::setprecision(1) << std::showpos << r.elo
+               << std::noshowpos << " +/- " << r.error << "  "
+               << r.games << " games, " << 100.0 * r.score << "%";
+            Core::Logger::log(
+                Core::Logger::Level::INFO,
+                "  ", rank + 1, ". ", names[order[rank]],
+                "  ", ss.str()
+            );
+        }
+    }
+}
+
 int main(int argc, char* argv[]) {
     signal(SIGPIPE, SIG_IGN);
     sigset_t block_mask;
@@ -45,7 +142,16 @@ int main(int argc, char* argv[]) {
         auto runs = App::CLI::expand_batch(bc);
         if (bc.debug)
             Core::Logger::set_level(Core::Logger::Level::DEBUG);
-        Analysis::GlobalCache::init(bc.board_size);
+        Analysis::GlobalCache::init(bc.board_size, bc.eval_cache_size);
+
+        if (!bc.cgroup.empty() &&
+            !Sys::Cgroup::init({bc.cgroup, bc.cgroup_cpus, bc.cgroup_cpuset})) {
+            Core::Logger::log(
+                Core::Logger::Level::ERROR,
+                "Cannot set up cgroup sandbox under: ", bc.cgroup
+            );
+            return Core::Constants::EXIT_CODE_SYSTEM_FAILURE;
+        }
 
         if (!bc.api_url.empty()) {
             api = std::make_shared<Net::ApiManager>(
@@ -55,6 +161,19 @@ int main(int argc, char* argv[]) {
             if (bc.cleanup) api->reset();
         }
 
+        std::shared_ptr<App::Journal> journal;
+        if (!bc.journal.empty()) {
+            journal = std::make_shared<App::Journal>(
+                bc.journal, batch_identity(bc), bc.resume
+            );
+            if (journal->loaded() > 0) {
+                Core::Logger::log(
+                    Core::Logger::Level::INFO, "Resuming from journal ", bc.journal,
+                    ": ", journal->loaded(), " finished games"
+                );
+            }
+        }
+
         std::vector<std::vector<Core::Point>> ops;
         if (!bc.openings_path.empty()) {
             ops = Game::Openings::load(bc.openings_path);
@@ -67,14 +186,16 @@ int main(int argc, char* argv[]) {
             }
             if (bc.shuffle_openings) {
                 std::random_device rd;
-                std::mt19937 g(rd());
+                std::mt19937 g(journal ? (std::mt19937::result_type)journal->seed() : rd());
                 std::shuffle(ops.begin(), ops.end(), g);
             }
         }
 
         std::ofstream ndjson_out;
         if (!bc.export_results.empty()) {
-            ndjson_out.open(bc.export_results, std::ios::trunc);
+            ndjson_out.open(
+                bc.export_results, bc.resume ? std::ios::app : std::ios::trunc
+            );
             if (!ndjson_out) {
                 Core::Logger::log(
                     Core::Logger::Level::ERROR,
@@ -92,18 +213,87 @@ int main(int argc, char* argv[]) {
         std::vector<std::shared_ptr<App::RunContext>> contexts;
         std::deque<App::GameParams> global_game_queue;
 
+        std::shared_ptr<Sys::CoreAllocator> cores;
+        if (bc.pin) {
+            auto allowed = Sys::Affinity::allowed();
+            std::vector<Sys::Affinity::Cpu> cpus;
+            for (const auto& c : Sys::Affinity::topology()) {
+                if (std::find(allowed.begin(), allowed.end(), c.id) != allowed.end() &&
+                    std::find(bc.eval_cpus.begin(), bc.eval_cpus.end(), c.id) ==
+                        bc.eval_cpus.end())
+                    cpus.push_back(c);
+            }
+            cores = std::make_shared<Sys::CoreAllocator>(cpus, bc.oversubscribe);
+
+            size_t need = 2 * (size_t)bc.concurrency;
+            if (!bc.eval_cmd.empty() && bc.eval_cpus.empty()) need += bc.eval_procs;
+            if (cores->slots() < need && !bc.oversubscribe) {
+                Core::Logger::log(
+                    Core::Logger::Level::ERROR,
+                    "--pin needs ", need, " cores but only ", cores->slots(),
+                    " are free; lower --concurrency or add --oversubscribe"
+                );
+                return Core::Constants::EXIT_CODE_SYSTEM_FAILURE;
+            }
+        }
+
+        std::shared_ptr<Sys::ProcessPool> pool;
+        if (bc.reuse_engines || bc.prespawn > 0) {
+            pool = std::make_shared<Sys::ProcessPool>(
+                2 * (size_t)bc.concurrency, bc.reuse_engines
+            );
+        }
+
+        std::unique_ptr<App::Scheduler> scheduler;
+        if (bc.adaptive) {
+            App::Scheduler::Options so;
+            so.budget = bc.budget;
+            scheduler = std::make_unique<App::Scheduler>(so);
+        }
+
+        std::vector<std::shared_ptr<App::RunContext>> complete;
         for (size_t run_idx = 0; run_idx < runs.size(); ++run_idx) {
             const auto& rs = runs[run_idx];
             Core::Config cfg = App::CLI::build_config(bc, rs);
             auto ctx = std::make_shared<App::RunContext>();
 
             ctx->id = Core::Utils::generate_run_id();
-            ctx->cfg = cfg;
             ctx->run_spec = rs;
+            if (!bc.tune_path.empty()) {
+                App::Tuner::Options to;
+                to.iterations = cfg.max_pairs;
+                to.checkpoint = bc.tune_checkpoint;
+                to.seed = rs.seed ? *rs.seed : std::random_device{}();
+                auto params = App::Tuner::load(bc.tune_path);
+                struct stat st;
+                if (!to.checkpoint.empty() && stat(to.checkpoint.c_str(), &st) == 0) {
+                    params = App::Tuner::load(to.checkpoint, &to.start);
+                    Core::Logger::log(
+                        Core::Logger::Level::INFO, "Resuming SPSA from ",
+                        to.checkpoint, " at iteration ", to.start
+                    );
+                }
+                if (to.start >= to.iterations) {
+                    throw std::runtime_error(
+                        "Tuning already finished " + std::to_string(to.start) +
+                        " iterations; raise --max-pairs to continue"
+                    );
+                }
+                cfg.max_pairs -= to.start;
+                cfg.min_pairs = std::min(cfg.min_pairs, cfg.max_pairs);
+                ctx->tuner = std::make_shared<App::Tuner>(std::move(params), to);
+            }
+            ctx->cfg = cfg;
             ctx->config_label = App::CLI::generate_config_label(cfg);
+            if (bc.tournament != Core::Tournament::NONE) {
+                ctx->config_label =
+                    Core::Utils::command_name(cfg.bot1.cmd) + " vs " +
+                    Core::Utils::command_name(cfg.bot2.cmd) +
+                    (ctx->config_label == "default" ? "" : ", " + ctx->config_label);
+            }
             ctx->total_games_expected = cfg.max_pairs * 2;
             ctx->run_start = std::chrono::steady_clock::now();
-            ctx->run_start_cpu = Sys::CpuMonitor::get_times(getpid());
+            ctx->run_start_cpu_ns = Sys::CpuClock::self().ns();
             contexts.push_back(ctx);
 
             Core::Logger::log(
@@ -114,12 +304,42 @@ int main(int argc, char* argv[]) {
                 " pairs=", rs.min_pairs, "-", rs.max_pairs
             );
 
+            bool finished = false;
+            if (journal) {
+                ctx->journal = journal;
+                ctx->journal_key = App::Journal::key(rs);
+                int pairs = journal->replay(ctx->journal_key, *ctx);
+                if (scheduler) scheduler->restored(*ctx, pairs);
+                if (Stats::SPRT::check(ctx->match_state, cfg) ||
+                    (scheduler && !cfg.sprt.enabled &&
+                     scheduler->decided(ctx->match_state, cfg)))
+                    ctx->stop_flag = true;
+                finished = journal->finished(ctx->journal_key);
+                if (finished) std::call_once(ctx->finalized_flag, []() {});
+                if (ctx->games_completed > 0) {
+                    Core::Logger::log(
+                        Core::Logger::Level::INFO, "Restored ", ctx->games_completed.load(),
+                        " of ", ctx->total_games_expected, " games from the journal",
+                        finished ? " (run finished)" : ""
+                    );
+                }
+            }
+
             auto games = App::CLI::create_pending_games(
                 cfg, ops, rs.seed, ctx, ctx->id
             );
+            size_t queued = 0;
             for (auto& g : games) {
+                auto it = ctx->match_state.results.find(g.pair);
+                if (finished || (it != ctx->match_state.results.end() &&
+                    (g.leg == 0 ? it->second.first : it->second.second) >
+                        Core::Constants::PAIR_RESULT_THRESHOLD))
+                    continue;
+                g.pool = pool;
                 global_game_queue.push_back(std::move(g));
+                queued++;
             }
+            if (!finished && queued == 0) complete.push_back(ctx);
         }
 
         Core::Logger::log(
@@ -127,23 +347,72 @@ int main(int argc, char* argv[]) {
             "Queued ", global_game_queue.size(), " games."
         );
 
-        std::deque<App::EvalJob> eval_queue;
-        std::deque<std::shared_ptr<Game::Referee>> game_queue;
+        std::deque<App::ReadyGame> game_queue;
+        Stats::QueueWait play_wait;
         std::mutex task_mtx;
         std::condition_variable task_cv;
         std::atomic<int> active_games = 0;
         std::mutex ndjson_mtx;
+        for (auto& ctx : complete)
+            App::finalize_run(ctx, bc, ndjson_out, ndjson_mtx, api);
 
         auto& primary_cfg = contexts[0]->cfg;
         Sys::g_stop_flag = 0;
         std::vector<std::thread> workers;
 
+        std::unique_ptr<App::EvalService> evals;
+        if (!bc.eval_cmd.empty()) {
+            App::EvalService::Options eo;
+            eo.cmd = bc.eval_cmd;
+            eo.board_size = bc.board_size;
+            eo.rule = bc.rule;
+            eo.timeout_cutoff = bc.eval_timeout_cutoff;
+            eo.exit_on_crash = bc.exit_on_crash;
+            eo.max_nodes = bc.eval_nodes_list.empty()
+                ? Core::Constants::DEFAULT_EVAL_NODES
+                : bc.eval_nodes_list[0];
+            eo.procs = bc.eval_procs;
+            eo.queue_max = (size_t)bc.eval_queue;
+            eo.idle_ms = bc.eval_idle_ms;
+            eo.cpus = bc.eval_cpus;
+            eo.cores = cores;
+            eo.on_drained = [&](const std::shared_ptr<App::RunContext>& ctx) {
+                if (ctx->games_completed + ctx->games_skipped >= ctx->total_games_expected)
+                    App::finalize_run(ctx, bc, ndjson_out, ndjson_mtx, api);
+            };
+            if (!bc.eval_cache.empty()) {
+                Analysis::GlobalCache::open(
+                    bc.eval_cache,
+                    {
+                        command_identity(eo.cmd) + "|rule=" +
+                            std::to_string(static_cast<int>(eo.rule)),
+                        eo.board_size, eo.max_nodes
+                    }
+                );
+            }
+            evals = std::make_unique<App::EvalService>(std::move(eo));
+            evals->start();
+        }
+
+        Sys::Reactor reactor;
+        std::atomic<bool> reactor_done{false};
+        std::thread reactor_thread;
+        if (reactor.valid()) {
+            reactor_thread = std::thread([&]() {
+                while (!reactor_done)
+                    reactor.run_once(Core::Constants::POLL_TIMEOUT_MS);
+            });
+        }
+
         for (int i = 0; i < primary_cfg.threads; ++i) {
             workers.emplace_back([&, cfg = primary_cfg]() {
                 App::WorkerState ws{
-                    eval_queue, game_queue, global_game_queue,
+                    game_queue, global_game_queue,
                     task_mtx, task_cv, active_games, api,
-                    contexts, bc, ndjson_out, ndjson_mtx
+                    contexts, bc, ndjson_out, ndjson_mtx,
+                    reactor.valid() ? &reactor : nullptr,
+                    pool, bc.prespawn, evals.get(), &play_wait, cores,
+                    scheduler.get()
                 };
                 try {
                     App::interleaved_worker_loop(cfg, ws);
@@ -157,6 +426,18 @@ int main(int argc, char* argv[]) {
             });
         }
         for (auto& t : workers) t.join();
+        {
+            std::lock_guard<std::mutex> l(task_mtx);
+            game_queue.clear();
+        }
+        reactor_done = true;
+        reactor.wake();
+        if (reactor_thread.joinable()) reactor_thread.join();
+        if (evals) {
+            evals->drain();
+            evals->stop();
+        }
+        Analysis::GlobalCache::close();
 
         Core::Logger::log(
             Core::Logger::Level::INFO,
@@ -171,6 +452,64 @@ int main(int argc, char* argv[]) {
             ctx->stats.print();
             if (ctx->stats.crashes.load() > 0) had_bot_failure = true;
         }
+        if (bc.tournament != Core::Tournament::NONE) log_tournament(bc, contexts);
+
+        if (scheduler) {
+            int planned = 0;
+            for (const auto& ctx : contexts) planned += ctx->cfg.max_pairs;
+            Core::Logger::log(
+                Core::Logger::Level::INFO,
+                "Adaptive scheduler: ", scheduler->scheduled(), " of ", planned,
+                " pairs scheduled"
+            );
+        }
+
+        if (pool) {
+            auto ps = pool->stats();
+            Core::Logger::log(
+                Core::Logger::Level::INFO,
+                "Engine pool: ", ps.reused, " reused, ", ps.spawned,
+                " spawned, ", ps.discarded, " discarded"
+            );
+            if (bc.prespawn > 0) {
+                Core::Logger::log(
+                    Core::Logger::Level::INFO,
+                    "Prespawn: ", ps.primed_used, "/", ps.primed,
+                    " primed engines used, ", ps.hidden_ms,
+                    "ms startup hidden"
+                );
+            }
+        }
+
+        auto log_wait = [](const char* cls, const Stats::QueueWait& w) {
+            auto s = w.summary();
+            Core::Logger::log(
+                Core::Logger::Level::INFO,
+                "Queue wait (", cls, "): ", s.count, " dispatches, mean ",
+                std::fixed, std::setprecision(2), s.mean_ms, "ms, p99 ",
+                s.p99_ms, "ms, max ", s.max_ms, "ms"
+            );
+        };
+        log_wait("play", play_wait);
+        if (evals) log_wait("analysis", evals->queue_wait());
+
+        if (evals) {
+            auto es = evals->stats();
+            Core::Logger::log(
+                Core::Logger::Level::INFO,
+                "Evaluator: ", es.jobs, " positions, ", es.cache_hits,
+                " cache hits, ", es.spawns, " spawns, ", es.idle_shutdowns,
+                " idle shutdowns, ", es.delta_syncs, " delta / ",
+                es.full_syncs, " full board syncs, ", es.whole_games,
+                " whole games"
+            );
+            auto cc = Analysis::GlobalCache::counters();
+            Core::Logger::log(
+                Core::Logger::Level::INFO,
+                "Eval cache: ", cc.hits, " hits, ", cc.misses, " misses, ",
+                cc.evictions, " evictions, ", cc.loaded, " loaded from file"
+            );
+        }
 
         if (ndjson_out) {
             ndjson_out.close();
@@ -188,6 +527,7 @@ int main(int argc, char* argv[]) {
             : Core::Constants::EXIT_CODE_SUCCESS;
 
     } catch (const Core::MatchTerminated&) {
+        Analysis::GlobalCache::close();
         if (api) api->stop();
         curl_global_cleanup();
         return had_bot_failure
@@ -197,6 +537,7 @@ int main(int argc, char* argv[]) {
         Core::Logger::log(
             Core::Logger::Level::ERROR, "Fatal error: ", e.what()
         );
+        Analysis::GlobalCache::close();
         if (api) api->stop();
         curl_global_cleanup();
         return Core::Constants::EXIT_CODE_SYSTEM_FAILURE;
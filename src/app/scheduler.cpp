@@ -0,0 +1,102 @@
+#include "scheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "../core/logger.h"
+
+namespace Arena::App {
+
+    Scheduler::Scheduler(Options o) : opt_(o) {}
+
+    Scheduler::Interval Scheduler::interval(
+        const std::array<int, 5>& penta, int pairs, double z)
+    {
+        double n = 0, sum = 0, sq = 0;
+        for (size_t i = 0; i < penta.size(); ++i) {
+            double c = penta[i] + Core::Constants::RACE_PENTA_PRIOR;
+            double x = i / 4.0;
+            n += c; sum += c * x; sq += c * x * x;
+        }
+        double mean = sum / n;
+        double var = std::max(0.0, sq / n - mean * mean);
+        return {mean, z * std::sqrt(var / std::max(pairs, 1))};
+    }
+
+    Scheduler::Interval Scheduler::interval(const MatchState& state) const {
+        return interval(state.penta, state.pairs_done, opt_.z);
+    }
+
+    double Scheduler::spending_z(double alpha, int look) {
+        double n = std::max(look, 1);
+        double a = alpha * 6.0 / (M_PI * M_PI * n * n);
+        double lo = 0, hi = 40;
+        for (int it = 0; it < Core::Constants::SPRT_BISECT_ITERATIONS; ++it) {
+            double mid = 0.5 * (lo + hi);
+            if (std::erfc(mid / std::sqrt(2.0)) > a) lo = mid; else hi = mid;
+        }
+        return 0.5 * (lo + hi);
+    }
+
+    bool Scheduler::decided(const MatchState& state, const Core::Config& cfg) const {
+        int n = state.pairs_done;
+        if (n < std::max(cfg.min_pairs, 2)) return false;
+        auto iv = interval(state.penta, n, spending_z(opt_.alpha, n));
+        return std::abs(iv.mean - 0.5) > iv.half_width;
+    }
+
+    size_t Scheduler::pick(const std::deque<GameParams>& queue) {
+        std::vector<std::pair<RunContext*, size_t>> heads;
+        for (size_t i = 0; i < queue.size(); ++i) {
+            auto* ctx = queue[i].context.get();
+            if (!ctx) return i;
+            bool seen = false;
+            for (const auto& h : heads) seen = seen || h.first == ctx;
+            if (seen) continue;
+            if (ctx->stop_flag || queue[i].leg == 1) return i;
+            heads.push_back({ctx, i});
+        }
+        if (heads.empty()) return 0;
+
+        if (opt_.budget > 0 && scheduled_ >= opt_.budget) {
+            if (!budget_spent_) {
+                Core::Logger::log(
+                    Core::Logger::Level::INFO,
+                    "Budget of ", opt_.budget, " pairs spent, stopping ",
+                    heads.size(), " undecided run(s)"
+                );
+                budget_spent_ = true;
+            }
+            for (auto& h : heads) h.first->stop_flag = true;
+            return heads.front().second;
+        }
+
+        size_t best = heads.front().second;
+        std::pair<int, double> best_key{-1, 0};
+        for (const auto& [ctx, idx] : heads) {
+            int n = pairs_[ctx];
+            std::pair<int, double> key;
+            if (n < ctx->cfg.min_pairs) {
+                key = {1, -(double)n};
+            } else {
+                std::lock_guard<std::mutex> l(ctx->match_state.mtx);
+                key = {0, interval(ctx->match_state.penta, n, opt_.z).half_width};
+            }
+            if (key > best_key) {
+                best_key = key;
+                best = idx;
+            }
+        }
+        return best;
+    }
+
+    void Scheduler::dispatched(const GameParams& g) {
+        if (g.leg != 0) return;
+        pairs_[g.context.get()]++;
+        scheduled_++;
+    }
+
+    void Scheduler::restored(const RunContext& ctx, int pairs) {
+        pairs_[&ctx] += pairs;
+        scheduled_ += pairs;
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <deque>
+#include <unordered_map>
+#include "context.h"
+
+namespace Arena::App {
+
+    class Scheduler {
+    public:
+        struct Options {
+            int budget = 0;
+            double z = Core::Constants::RACE_CONFIDENCE_Z;
+            double alpha = Core::Constants::RACE_ALPHA;
+        };
+
+        struct Interval {
+            double mean = 0.5;
+            double half_width = 0.5;
+        };
+
+        explicit Scheduler(Options o);
+
+        size_t pick(const std::deque<GameParams>& queue);
+        void dispatched(const GameParams& g);
+        void restored(const RunContext& ctx, int pairs);
+        bool decided(const MatchState& state, const Core::Config& cfg) const;
+        Interval interval(const MatchState& state) const;
+        int scheduled() const { return scheduled_; }
+
+        static Interval interval(const std::array<int, 5>& penta, int pairs, double z);
+        static double spending_z(double alpha, int look);
+
+    private:
+        Options opt_;
+        int scheduled_ = 0;
+        bool budget_spent_ = false;
+        std::unordered_map<const RunContext*, int> pairs_;
+    };
+}
@@ -0,0 +1,197 @@
+#include "tuner.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include "../core/constants.h"
+
+namespace Arena::App {
+
+    namespace {
+        std::string trim(const std::string& s) {
+            size_t b = s.find_first_not_of(" \t\r");
+            size_t e = s.find_last_not_of(" \t\r");
+            return b == std::string::npos ? "" : s.substr(b, e - b + 1);
+        }
+
+        bool is_integer(const std::string& s) {
+            return s.find_first_of(".eE") == std::string::npos;
+        }
+    }
+
+    std::vector<Tuner::Param> Tuner::parse(std::istream& in, int* iteration) {
+        std::vector<Param> params;
+        std::string line;
+        int n = 0;
+        while (std::getline(in, line)) {
+            n++;
+            size_t hash = line.find('#');
+            if (hash != std::string::npos) {
+                std::istringstream ss(line.substr(hash + 1));
+                std::string key;
+                int k;
+                if (iteration && ss >> key >> k && key == "iteration") *iteration = k;
+                line.erase(hash);
+            }
+            line = trim(line);
+            if (line.empty()) continue;
+
+            std::vector<std::string> f;
+            std::stringstream ss(line);
+            std::string item;
+            while (std::getline(ss, item, ',')) f.push_back(trim(item));
+            auto fail = [&](const std::string& why) {
+                return std::runtime_error(
+                    "Tune file line " + std::to_string(n) + ": " + why
+                );
+            };
+            if (f.size() != 6) throw fail("expected name, value, min, max, c_end, r_end");
+            if (f[0].empty() || f[0].find_first_of(" \t") != std::string::npos)
+                throw fail("bad parameter name");
+
+            Param p;
+            p.name = f[0];
+            try {
+                p.value = std::stod(f[1]);
+                p.min = std::stod(f[2]);
+                p.max = std::stod(f[3]);
+                p.c_end = std::stod(f[4]);
+                p.r_end = std::stod(f[5]);
+            } catch (const std::exception&) {
+                throw fail("bad number");
+            }
+            p.integer = is_integer(f[2]) && is_integer(f[3]);
+            if (p.min >= p.max) throw fail("min must be below max");
+            if (p.value < p.min || p.value > p.max) throw fail("value out of range");
+            if (p.c_end <= 0 || p.r_end <= 0) throw fail("c_end and r_end must be > 0");
+            params.push_back(p);
+        }
+        if (params.empty()) throw std::runtime_error("Tune file has no parameters");
+        return params;
+    }
+
+    std::vector<Tuner::Param> Tuner::load(const std::string& path, int* iteration) {
+        std::ifstream file(path);
+        if (!file.is_open()) throw std::runtime_error("Cannot open tune file: " + path);
+        return parse(file, iteration);
+    }
+
+    Tuner::Tuner(std::vector<Param> params, Options o)
+        : opt_(std::move(o)), params_(std::move(params)),
+          issued_(opt_.start), done_(opt_.start), rng_(opt_.seed) {}
+
+    double Tuner::c_k(const Param& p, int k) const {
+        double n = std::max(opt_.iterations, 1);
+        double c = p.c_end * std::pow(n, Core::Constants::SPSA_GAMMA);
+        return c / std::pow(k + 1, Core::Constants::SPSA_GAMMA);
+    }
+
+    double Tuner::a_k(const Param& p, int k) const {
+        double n = std::max(opt_.iterations, 1);
+        double big_a = Core::Constants::SPSA_A_RATIO * n;
+        double a = p.r_end * p.c_end * p.c_end *
+            std::pow(big_a + n, Core::Constants::SPSA_ALPHA);
+        return a / std::pow(big_a + k + 1, Core::Constants::SPSA_ALPHA);
+    }
+
+    std::string Tuner::format(const Param& p, double v) const {
+        v = std::clamp(v, p.min, p.max);
+        if (p.integer) return std::to_string(std::lround(v));
+        std::ostringstream ss;
+        ss << v;
+        return ss.str();
+    }
+
+    std::vector<std::pair<std::string, std::string>> Tuner::values(int pair, bool plus) {
+        std::lock_guard<std::mutex> l(mtx_);
+        auto it = pending_.find(pair);
+        if (it == pending_.end()) {
+            Perturbation pt{issued_++, {}};
+            std::bernoulli_distribution coin(0.5);
+            for (size_t i = 0; i < params_.size(); ++i)
+                pt.flip.push_back(coin(rng_) ? 1 : -1);
+            it = pending_.emplace(pair, std::move(pt)).first;
+        }
+
+        std::vector<std::pair<std::string, std::string>> out;
+        for (size_t i = 0; i < params_.size(); ++i) {
+            const auto& p = params_[i];
+            double shift = c_k(p, it->second.k) * it->second.flip[i];
+            out.push_back({p.name, format(p, p.value + (plus ? shift : -shift))});
+        }
+        return out;
+    }
+
+    void Tuner::update(int pair, double plus_points) {
+        std::lock_guard<std::mutex> l(mtx_);
+        auto it = pending_.find(pair);
+        if (it == pending_.end()) return;
+
+        double result = 2.0 * plus_points - 2.0;
+        for (size_t i = 0; i < params_.size(); ++i) {
+            auto& p = params_[i];
+            int k = it->second.k;
+            p.value += a_k(p, k) / c_k(p, k) * result * it->second.flip[i];
+            p.value = std::clamp(p.value, p.min, p.max);
+        }
+        pending_.erase(it);
+        if (++done_ % Core::Constants::SPSA_CHECKPOINT_PAIRS == 0) save_locked();
+    }
+
+    void Tuner::discard(int pair) {
+        std::lock_guard<std::mutex> l(mtx_);
+        pending_.erase(pair);
+    }
+
+    void Tuner::save() const {
+        std::lock_guard<std::mutex> l(mtx_);
+        save_locked();
+    }
+
+    void Tuner::save_locked() const {
+        if (opt_.checkpoint.empty()) return;
+        std::string tmp = opt_.checkpoint + ".tmp";
+        {
+            std::ofstream out(tmp, std::ios::trunc);
+            if (!out) return;
+            out << "# iteration " << done_ << "\n";
+            out.precision(10);
+            for (const auto& p : params_) {
+                auto bound = [&](double v) {
+                    if (p.integer) return std::to_string(std::lround(v));
+                    std::string s = format(p, v);
+                    return is_integer(s) ? s + ".0" : s;
+                };
+                out << p.name << ", " << p.value << ", " << bound(p.min) << ", "
+                    << bound(p.max) << ", " << p.c_end << ", " << p.r_end << "\n";
+            }
+            if (!out.flush()) return;
+        }
+        std::rename(tmp.c_str(), opt_.checkpoint.c_str());
+    }
+
+    std::vector<Tuner::Param> Tuner::params() const {
+        std::lock_guard<std::mutex> l(mtx_);
+        return params_;
+    }
+
+    int Tuner::iteration() const {
+        std::lock_guard<std::mutex> l(mtx_);
+        return done_;
+    }
+
+    std::string Tuner::summary() const {
+        std::lock_guard<std::mutex> l(mtx_);
+        std::ostringstream ss;
+        ss << "iteration " << done_ << "/" << opt_.iterations;
+        for (const auto& p : params_) {
+            ss << ", " << p.name << "=";
+            if (p.integer) ss << std::fixed << std::setprecision(2) << p.value;
+            else ss << std::defaultfloat << p.value;
+        }
+        return ss.str();
+    }
+}
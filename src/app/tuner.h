@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Arena::App {
+
+    class Tuner {
+    public:
+        struct Param {
+            std::string name;
+            double value = 0, min = 0, max = 0;
+            double c_end = 0, r_end = 0;
+            bool integer = false;
+        };
+
+        struct Options {
+            int iterations = 0;
+            int start = 0;
+            uint64_t seed = 0;
+            std::string checkpoint;
+        };
+
+        static std::vector<Param> parse(std::istream& in, int* iteration = nullptr);
+        static std::vector<Param> load(const std::string& path, int* iteration = nullptr);
+
+        Tuner(std::vector<Param> params, Options o);
+
+        std::vector<std::pair<std::string, std::string>> values(int pair, bool plus);
+        void update(int pair, double plus_points);
+        void discard(int pair);
+        void save() const;
+
+        std::vector<Param> params() const;
+        int iteration() const;
+        std::string summary() const;
+
+    private:
+        struct Perturbation {
+            int k;
+            std::vector<int> flip;
+        };
+
+        double c_k(const Param& p, int k) const;
+        double a_k(const Param& p, int k) const;
+        std::string format(const Param& p, double v) const;
+        void save_locked() const;
+
+        Options opt_;
+        mutable std::mutex mtx_;
+        std::vector<Param> params_;
+        int issued_, done_;
+        std::mt19937_64 rng_;
+        std::map<int, Perturbation> pending_;
+    };
+}
@@ -1,29 +1,52 @@
 #include "worker.h"
-#include "../analysis/evaluator.h"
-#include "../analysis/cache.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
 #include "../core/logger.h"
 #include "../sys/signals.h"
 #include "../sys/cpu_monitor.h"
 #include "../net/json.h"
 #include "../stats/sprt.h"
+#include "journal.h"
+#include "tuner.h"
 
 namespace Arena::App {
 
+struct PrespawnJob {
+    std::string key;
+    Core::BotConfig cfg;
+    long long memory = 0;
+    std::map<std::string, std::string> env;
+    int board_size = 0;
+};
+
 struct TaskResult {
-    std::optional<EvalJob> eval;
     std::shared_ptr<Game::Referee> game;
     bool stop = false;
     bool retry = false;
+    std::optional<PrespawnJob> prespawn{};
+    std::optional<std::chrono::steady_clock::time_point> ready{};
 };
 
-static void update_pair_outcome(
-    MatchState& state, double res_first, double res_second)
-{
-    if (res_first < 0 || res_second < 0) return;
-    double total_score = res_first + (1.0 - res_second);
-    if (total_score > 1.0) state.wins++;
-    else if (total_score < 1.0) state.losses++;
-    else state.draws++;
+static std::string format_sprt(const MatchState& state, const Core::Config& cfg) {
+    auto [lower, upper] = Stats::SPRT::bounds(cfg.sprt.alpha, cfg.sprt.beta);
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(2)
+       << "LLR " << Stats::SPRT::llr(state.penta, cfg.sprt.elo0, cfg.sprt.elo1)
+       << " [" << lower << ", " << upper << "] elo " << cfg.sprt.elo0
+       << ".." << cfg.sprt.elo1 << " penta ";
+    for (size_t i = 0; i < state.penta.size(); ++i)
+        ss << (i ? "/" : "") << state.penta[i];
+    ss << " after " << state.pairs_done << " pairs";
+    return ss.str();
+}
+
+static const char* sprt_verdict(Stats::SPRT::Decision d) {
+    switch (d) {
+        case Stats::SPRT::Decision::ACCEPT_H1: return "H1 accepted";
+        case Stats::SPRT::Decision::ACCEPT_H0: return "H0 accepted";
+        default: return "inconclusive";
+    }
 }
 
 static void populate_event_stats(
@@ -70,8 +93,8 @@ std::string format_ndjson_line(
     double p2_efficiency
 ) {
     Net::JsonStream js;
-    js.add_str("p1_cmd", bc.p1_cmd);
-    js.add_str("p2_cmd", bc.p2_cmd);
+    js.add_str("p1_cmd", bc.engine_cmd(rs.p1_engine));
+    js.add_str("p2_cmd", bc.engine_cmd(rs.p2_engine));
     js.add("p1_nodes", rs.p1_nodes);
     js.add("p2_nodes", rs.p2_nodes);
     js.add("eval_nodes", rs.eval_nodes);
@@ -89,6 +112,18 @@ std::string format_ndjson_line(
     js.add("losses", state.losses);
     js.add("draws", state.draws);
     js.add("pairs", state.pairs_done);
+    if (bc.sprt.enabled) {
+        auto [lower, upper] = Stats::SPRT::bounds(bc.sprt.alpha, bc.sprt.beta);
+        js.add("llr", Stats::SPRT::llr(state.penta, bc.sprt.elo0, bc.sprt.elo1));
+        js.add("llr_lower", lower);
+        js.add("llr_upper", upper);
+        js.add("elo0", bc.sprt.elo0);
+        js.add("elo1", bc.sprt.elo1);
+        std::string penta = "[";
+        for (size_t i = 0; i < state.penta.size(); ++i)
+            penta += (i ? "," : "") + std::to_string(state.penta[i]);
+        js.add_raw("penta", penta + "]");
+    }
 
     {
         Net::JsonStream p1;
@@ -103,7 +138,7 @@ std::string format_ndjson_line(
     return js.str();
 }
 
-static void finalize_run(
+void finalize_run(
     std::shared_ptr<RunContext> ctx,
     const Core::BatchConfig& bc,
     std::ofstream& ndjson_out,
@@ -113,22 +148,19 @@ static void finalize_run(
     if (!ctx) return;
     std::call_once(ctx->finalized_flag, [&]() {
         auto now = std::chrono::steady_clock::now();
-        long run_wall = std::chrono::duration_cast<std::chrono::milliseconds>(
+        long long run_wall = std::chrono::duration_cast<std::chrono::nanoseconds>(
             now - ctx->run_start
         ).count();
-        auto proc_cpu = Sys::CpuMonitor::get_times(getpid());
         double load = Sys::CpuMonitor::calculate_load(
-            ctx->run_start_cpu, proc_cpu, run_wall
+            Sys::CpuClock::self().ns() - ctx->run_start_cpu_ns, run_wall
         );
 
-        double p1_efficiency = 0.0;
-        double p2_efficiency = 0.0;
-        if (ctx->total_p1_wall > 0) p1_efficiency =
-            (double)ctx->total_p1_cpu * 100.0 /
-            static_cast<double>(ctx->total_p1_wall);
-        if (ctx->total_p2_wall > 0) p2_efficiency =
-            (double)ctx->total_p2_cpu * 100.0 /
-            static_cast<double>(ctx->total_p2_wall);
+        double p1_efficiency = Sys::CpuMonitor::calculate_load(
+            ctx->total_p1_cpu_ns, ctx->total_p1_wall_ns
+        );
+        double p2_efficiency = Sys::CpuMonitor::calculate_load(
+            ctx->total_p2_cpu_ns, ctx->total_p2_wall_ns
+        );
 
         if (api) {
             Net::ApiManager::Event e;
@@ -164,48 +196,137 @@ static void finalize_run(
              Core::Logger::Level::INFO,
              "Run ", ctx->config_label, " finished (ID: ", ctx->id, ")"
         );
+        if (ctx->cfg.sprt.enabled) {
+            std::lock_guard<std::mutex> l(ctx->match_state.mtx);
+            Core::Logger::log(
+                Core::Logger::Level::INFO, "SPRT ",
+                sprt_verdict(Stats::SPRT::decide(ctx->match_state, ctx->cfg)),
+                ": ", format_sprt(ctx->match_state, ctx->cfg)
+            );
+        }
+        if (ctx->journal && !Sys::g_stop_flag)
+            ctx->journal->record_finish(ctx->journal_key, ctx->stats);
+        if (ctx->tuner) {
+            ctx->tuner->save();
+            Core::Logger::log(
+                Core::Logger::Level::INFO, "SPSA finished at ", ctx->tuner->summary()
+            );
+        }
         ctx->stats.print();
     });
 }
 
+static std::optional<PrespawnJob> plan_prespawn(WorkerState& ws, bool commit) {
+    if (!ws.pool || ws.prespawn_depth <= 0) return std::nullopt;
+    if (ws.bc.threads > 1 && ws.pool->reserved() >= (size_t)ws.bc.threads - 1)
+        return std::nullopt;
+
+    std::map<std::string, size_t> need;
+    size_t depth = std::min(
+        ws.global_game_queue.size(), (size_t)ws.prespawn_depth
+    );
+    for (size_t i = 0; i < depth; ++i) {
+        const auto& g = ws.global_game_queue[i];
+        if (!g.context || g.context->stop_flag) continue;
+        for (const auto* cfg : {&g.p1_cfg, &g.p2_cfg}) {
+            std::string key = g.pool_key(*cfg);
+            if (!ws.pool->reserve(key, ++need[key], commit)) continue;
+            return PrespawnJob{
+                key, *cfg, g.spawn_memory(*cfg), g.spawn_env(),
+                g.config().board_size
+            };
+        }
+    }
+    return std::nullopt;
+}
+
+static void run_prespawn(const PrespawnJob& job, Sys::ProcessPool& pool) {
+    auto t0 = std::chrono::steady_clock::now();
+    Game::Player pl(job.cfg.cmd, "PRE");
+    try {
+        if (!pl.start(job.memory, job.env))
+            throw std::runtime_error("start failed");
+        pl.meta();
+
+        auto cfg = job.cfg;
+        cfg.calculate_timeout(pl.name());
+        pl.send("START " + std::to_string(job.board_size));
+        long e = 0;
+        if (pl.read(cfg.timeout_cutoff, e) != "OK")
+            throw Core::PlayerError("Expected OK");
+    } catch (const std::exception& e) {
+        Core::Logger::log(
+            Core::Logger::Level::WARN,
+            "Prespawn of ", job.cfg.cmd, " failed: ", e.what()
+        );
+        pool.cancel(job.key);
+        return;
+    }
+
+    long startup_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - t0
+    ).count();
+    pool.fill(job.key, pl.detach(), startup_ms);
+}
+
 static TaskResult fetch_next_task(WorkerState& ws, int thread_limit) {
     std::unique_lock<std::mutex> l(ws.task_mtx);
+    auto can_admit = [&]() {
+        return ws.active_games < thread_limit && !ws.global_game_queue.empty() &&
+            !(ws.evals && ws.evals->saturated()) &&
+            (!ws.cores || ws.cores->can_acquire(2));
+    };
     ws.task_cv.wait_for(
         l, std::chrono::milliseconds(Core::Constants::WORKER_IDLE_WAIT_MS
     ), [&]{
-        return Sys::g_stop_flag || !ws.eval_queue.empty() || !ws.game_queue.empty() ||
-            (ws.active_games < thread_limit && !ws.global_game_queue.empty());
+        return Sys::g_stop_flag || !ws.game_queue.empty() || can_admit() ||
+            plan_prespawn(ws, false).has_value();
     });
 
-    if (Sys::g_stop_flag) return {std::nullopt, nullptr, true, false};
-
-    if (!ws.eval_queue.empty()) {
-        auto j = std::move(ws.eval_queue.front());
-        ws.eval_queue.pop_front();
-        return {std::move(j), nullptr, false, false};
-    }
+    if (Sys::g_stop_flag) return {nullptr, true, false};
 
     if (!ws.game_queue.empty()) {
         auto g = std::move(ws.game_queue.front());
         ws.game_queue.pop_front();
-        return {std::nullopt, std::move(g), false, false};
+        if (ws.play_wait) ws.play_wait->add_since(g.since);
+        return {std::move(g.game), false, false, std::nullopt, g.ready};
     }
 
-    if (ws.active_games < thread_limit && !ws.global_game_queue.empty()) {
+    if (can_admit()) {
+        if (ws.scheduler) {
+            size_t i = ws.scheduler->pick(ws.global_game_queue);
+            if (i > 0) {
+                auto g = std::move(ws.global_game_queue[i]);
+                ws.global_game_queue.erase(ws.global_game_queue.begin() + i);
+                ws.global_game_queue.push_front(std::move(g));
+            }
+        }
         auto p = std::move(ws.global_game_queue.front());
+        p.reactor = ws.reactor;
         ws.global_game_queue.pop_front();
 
         if (p.context && p.context->stop_flag) {
             if (++p.context->games_skipped + p.context->games_completed >=
-                p.context->total_games_expected) {
+                p.context->total_games_expected && p.context->evals_pending == 0) {
                 finalize_run(p.context, ws.bc, ws.ndjson_out, ws.ndjson_mtx, ws.api);
             }
-            return {std::nullopt, nullptr, false, true};
+            return {nullptr, false, true};
+        }
+
+        if (ws.cores && !(p.cores = ws.cores->acquire(2))) {
+            ws.global_game_queue.push_front(std::move(p));
+            return {nullptr, false, true};
         }
 
+        if (ws.scheduler) ws.scheduler->dispatched(p);
+        if (p.context && p.context->tuner) {
+            p.p1_cfg.info = p.context->tuner->values(p.pair, p.leg == 0);
+            p.p2_cfg.info = p.context->tuner->values(p.pair, p.leg != 0);
+        }
         ws.active_games++;
 
-        auto cb = [&ws, ctx = p.context, api = ws.api](
+        if (p.context->journal) p.tally = std::make_shared<GameTally>();
+        auto cb = [&ws, ctx = p.context, tally = p.tally, api = ws.api](
             int pair, int leg, double p1_score, long wall_ms, long, long
         ) {
             if (!ctx) return;
@@ -229,15 +350,56 @@ static TaskResult fetch_next_task(WorkerState& ws, int thread_limit) {
                 if (res.first > Core::Constants::PAIR_RESULT_THRESHOLD &&
                     res.second > Core::Constants::PAIR_RESULT_THRESHOLD)
                 {
-                    ctx->match_state.pairs_done++;
-                    update_pair_outcome(ctx->match_state, res.first, res.second);
+                    ctx->match_state.record_pair(res.first, res.second);
                     ctx->match_state.cv.notify_one();
 
-                    if (Stats::SPRT::check(ctx->match_state, ctx->cfg))
+                    if (ctx->tuner) {
+                        if (res.first < 0 || res.second < 0) ctx->tuner->discard(pair);
+                        else ctx->tuner->update(pair, res.first + (1.0 - res.second));
+                        if (ctx->should_log_progress()) {
+                            Core::Logger::log(
+                                Core::Logger::Level::INFO,
+                                "SPSA ", ctx->tuner->summary()
+                            );
+                        }
+                    } else if (Stats::SPRT::check(ctx->match_state, ctx->cfg)) {
+                        if (ctx->cfg.sprt.enabled && !ctx->stop_flag) {
+                            Core::Logger::log(
+                                Core::Logger::Level::INFO,
+                                "SPRT bound crossed for ", ctx->config_label, ": ",
+                                format_sprt(ctx->match_state, ctx->cfg)
+                            );
+                        }
                         ctx->stop_flag = true;
+                    } else if (ws.scheduler && !ctx->cfg.sprt.enabled &&
+                        ws.scheduler->decided(ctx->match_state, ctx->cfg)) {
+                        auto iv = ws.scheduler->interval(ctx->match_state);
+                        std::ostringstream ss;
+                        ss << std::fixed << std::setprecision(3)
+                           << iv.mean << " +/- " << iv.half_width;
+                        Core::Logger::log(
+                            Core::Logger::Level::INFO,
+                            "Run ", ctx->config_label, " decided after ",
+                            ctx->match_state.pairs_done, " pairs: score ", ss.str()
+                        );
+                        ctx->stop_flag = true;
+                    } else if (ctx->cfg.sprt.enabled && ctx->should_log_progress()) {
+                        Core::Logger::log(
+                            Core::Logger::Level::INFO,
+                            "SPRT ", ctx->config_label, ": ",
+                            format_sprt(ctx->match_state, ctx->cfg)
+                        );
+                    }
                 }
             }
 
+            if (tally) {
+                tally->pair = pair;
+                tally->leg = leg;
+                tally->p1_score = p1_score;
+                tally->wall_ms = wall_ms;
+            }
+
             if (api && ctx->should_send_update()) {
                 Net::ApiManager::Event e;
                 e.type = "run_update";
@@ -254,20 +416,18 @@ static TaskResult fetch_next_task(WorkerState& ws, int thread_limit) {
                 e.wall_time_ms = ctx->total_wall_time_ms;
 
                 auto now = std::chrono::steady_clock::now();
-                long run_wall = std::chrono::duration_cast<std::chrono::milliseconds>(
+                long long run_wall = std::chrono::duration_cast<std::chrono::nanoseconds>(
                     now - ctx->run_start
                 ).count();
-                auto proc_cpu = Sys::CpuMonitor::get_times(getpid());
                 e.arena_load = Sys::CpuMonitor::calculate_load(
-                    ctx->run_start_cpu, proc_cpu, run_wall
+                    Sys::CpuClock::self().ns() - ctx->run_start_cpu_ns, run_wall
+                );
+                e.p1_efficiency = Sys::CpuMonitor::calculate_load(
+                    ctx->total_p1_cpu_ns, ctx->total_p1_wall_ns
+                );
+                e.p2_efficiency = Sys::CpuMonitor::calculate_load(
+                    ctx->total_p2_cpu_ns, ctx->total_p2_wall_ns
                 );
-
-                if (ctx->total_p1_wall > 0) e.p1_efficiency =
-                    (double)ctx->total_p1_cpu * 100.0 /
-                    static_cast<double>(ctx->total_p1_wall);
-                if (ctx->total_p2_wall > 0) e.p2_efficiency =
-                    (double)ctx->total_p2_cpu * 100.0 /
-                    static_cast<double>(ctx->total_p2_wall);
 
                 {
                     std::lock_guard<std::mutex> lock(ctx->stats.mtx);
@@ -276,159 +436,101 @@ static TaskResult fetch_next_task(WorkerState& ws, int thread_limit) {
                 api->enqueue(e);
             }
 
-            if (++ctx->games_completed + ctx->games_skipped >=
-                ctx->total_games_expected) {
-                finalize_run(ctx, ws.bc, ws.ndjson_out, ws.ndjson_mtx, ws.api);
-            }
+            ++ctx->games_completed;
         };
 
         return {
-            std::nullopt,
             std::make_shared<Game::Referee>(p, ws.api, p.context->stats, cb),
             false, false
         };
     }
 
+    if (auto job = plan_prespawn(ws, true))
+        return {nullptr, false, false, std::move(job)};
+
     if (ws.global_game_queue.empty() && ws.game_queue.empty() &&
-        ws.eval_queue.empty() && ws.active_games == 0) {
-        Sys::g_stop_flag = 1;
+        ws.active_games == 0) {
         ws.task_cv.notify_all();
-        return {std::nullopt, nullptr, true, false};
+        return {nullptr, true, false};
     }
 
-    return {std::nullopt, nullptr, false, true};
+    return {nullptr, false, true};
 }
 
-void interleaved_worker_loop(const Core::Config& cfg, WorkerState& ws) {
-    std::unique_ptr<Analysis::Evaluator> eval;
-    if (!ws.bc.eval_cmd.empty()) {
-        eval = std::make_unique<Analysis::Evaluator>(
-            ws.bc.eval_cmd, ws.bc.board_size, ws.bc.eval_timeout_cutoff,
-            ws.bc.exit_on_crash,
-            ws.bc.eval_nodes_list.empty()
-                ? Core::Constants::DEFAULT_EVAL_NODES
-                : ws.bc.eval_nodes_list[0]
-        );
-        if (!eval->start()) eval.reset();
-    }
+static void park_game(WorkerState& ws, std::shared_ptr<Game::Referee> game) {
+    auto resume = [&q = ws.game_queue, &m = ws.task_mtx, &cv = ws.task_cv, game]() {
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> l(m);
+        q.push_back({game, now, now});
+        cv.notify_one();
+    };
+    if (!ws.reactor->watch(game->wait_fd(), game->deadline(), resume))
+        ws.game_queue.push_back({game, std::chrono::steady_clock::now()});
+}
 
+void interleaved_worker_loop(const Core::Config& cfg, WorkerState& ws) {
     while (true) {
-        auto task = fetch_next_task(ws, cfg.threads);
+        auto task = fetch_next_task(ws, cfg.concurrency);
         if (task.stop) break;
         if (task.retry) continue;
 
-        if (task.eval) {
-            if (!eval) continue;
-
-            auto& job = *task.eval;
-            bool debug = job.context->cfg.debug;
-            int board_size = job.context->cfg.board_size;
-
-            uint64_t h = Analysis::GlobalCache::hash(job.moves, board_size);
-            auto cached = Analysis::GlobalCache::get(h);
-
-            Stats::EvalMetrics m;
-
-            if (cached) {
-                m = *cached;
-                if (debug) {
-                    Core::Logger::log(
-                        Core::Logger::Level::DEBUG,
-                        "[CACHE HIT] Move ", job.moves.size(), " hash=", h
-                    );
-                }
-            } else {
-
-                if (debug) {
-                    Core::Logger::log(
-                        Core::Logger::Level::DEBUG,
-                        "[CACHE MISS] Move ", job.moves.size(), " hash=", h
-                    );
-                }
-
-                Sys::CpuMonitor::Times cpu_start{0, 0};
-                if (debug && eval)
-                    cpu_start = Sys::CpuMonitor::get_times(eval->pid());
+        if (task.prespawn) {
+            run_prespawn(*task.prespawn, *ws.pool);
+            continue;
+        }
 
-                auto t0 = std::chrono::steady_clock::now();
-                if (eval) {
-                    eval->set_max_nodes(job.max_nodes);
-                    m = eval->eval(job.moves);
-                }
-                auto t1 = std::chrono::steady_clock::now();
-
-                Analysis::GlobalCache::set(h, m);
-
-                if (debug && eval) {
-                    long wall_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                        t1 - t0
-                    ).count();
-                    auto cpu_end = Sys::CpuMonitor::get_times(eval->pid());
-                    double load = Sys::CpuMonitor::calculate_load(
-                        cpu_start, cpu_end, wall_ms
-                    );
-                    long cpu_ms = (cpu_end.user_ms - cpu_start.user_ms) +
-                        (cpu_end.sys_ms - cpu_start.sys_ms);
-                    Core::Logger::log(
-                        Core::Logger::Level::DEBUG,
-                        "Eval Move ", job.moves.size(), " | Wall: ", wall_ms,
-                        "ms | CPU: ", cpu_ms, "ms | Load: ", (int)load, "%"
-                    );
+        if (task.game) {
+            Core::MoveList hist;
+            auto status = ws.reactor
+                ? task.game->step_async(hist, task.ready)
+                : task.game->step(hist);
+
+            auto ctx = task.game->params().context;
+            uint64_t game_id = reinterpret_cast<uintptr_t>(task.game.get());
+            size_t opening = (size_t)task.game->get_opening_size();
+            bool finished = status == Game::Referee::Status::FINISHED;
+
+            if (ws.evals && cfg.eval_enabled() && ws.bc.eval_whole_game) {
+                auto full = task.game->history();
+                if (finished && full.size() > opening) {
+                    App::EvalJob job{
+                        full, task.game->get_last_mover_bot_id(), ctx,
+                        ctx->cfg.eval_max_nodes, game_id, true, opening
+                    };
+                    job.keys = task.game->position_keys();
+                    job.tally = task.game->params().tally;
+                    ws.evals->submit(std::move(job), false);
                 }
+            } else if (ws.evals && cfg.eval_enabled() && !hist.empty() &&
+                hist.size() > opening) {
+                App::EvalJob job{
+                    hist, task.game->get_last_mover_bot_id(), ctx,
+                    ctx->cfg.eval_max_nodes, game_id
+                };
+                job.keys = {task.game->position_keys().back()};
+                job.tally = task.game->params().tally;
+                ws.evals->submit(std::move(job), false);
             }
 
-            if (m.p_best < Core::Constants::GARBAGE_TIME_PROB_THRESHOLD) {
-                if (debug) {
-                    Core::Logger::log(
-                        Core::Logger::Level::DEBUG,
-                        "Move ", job.moves.size(), " SKIPPED (Garbage Time p_best=",
-                        std::fixed, std::setprecision(3), m.p_best, ")"
-                    );
-                }
-            } else {
-                double regret = std::max(0.0, m.p_best - m.p_played);
-                double sharpness = std::max(0.0, m.p_best - m.p_second);
-
-                if (debug) {
-                    Core::Logger::log(
-                        Core::Logger::Level::DEBUG,
-                        "Move ", job.moves.size(), " P", job.bot_id,
-                        " | p_best=", std::fixed, std::setprecision(4), m.p_best,
-                        " p_second=", m.p_second,
-                        " p_played=", m.p_played,
-                        " | Regret=", regret, " Sharpness=", sharpness
-                    );
+            if (ws.evals && finished) ws.evals->end_game(game_id);
+            if (finished && ctx) {
+                settle_game(*ctx, task.game->params().tally);
+                if (ctx->games_completed + ctx->games_skipped >=
+                    ctx->total_games_expected && ctx->evals_pending == 0) {
+                    finalize_run(ctx, ws.bc, ws.ndjson_out, ws.ndjson_mtx, ws.api);
                 }
-
-                if (regret > Core::Constants::METRIC_SEVERE_ERROR_REGRET) {
-                    Core::Logger::log(
-                        Core::Logger::Level::DEBUG,
-                        "BLUNDER: Move ", job.moves.size(), " P", job.bot_id,
-                        " Regret=", std::fixed, std::setprecision(3), regret,
-                        " (played=", m.p_played, " vs best=", m.p_best, ")"
-                    );
-                }
-
-                job.context->stats.add_metrics(job.bot_id, regret, sharpness);
             }
-        } else if (task.game) {
-            std::vector<Core::Point> hist;
-            auto status = task.game->step(hist);
-            std::lock_guard<std::mutex> l(ws.task_mtx);
 
-            if (cfg.eval_enabled() && !hist.empty() &&
-                hist.size() > (size_t)task.game->get_opening_size()) {
-                ws.eval_queue.push_back({
-                    hist,
-                    task.game->get_last_mover_bot_id(),
-                    task.game->params().context,
-                    task.game->params().context->cfg.eval_max_nodes
-                });
-            }
+            std::lock_guard<std::mutex> l(ws.task_mtx);
 
             if (status == Game::Referee::Status::RUNNING)
-                ws.game_queue.push_back(task.game);
-            else ws.active_games--;
+                ws.game_queue.push_back({task.game, std::chrono::steady_clock::now()});
+            else if (status == Game::Referee::Status::WAITING)
+                park_game(ws, task.game);
+            else {
+                task.game->release_cores();
+                ws.active_games--;
+            }
             ws.task_cv.notify_all();
         }
     }
@@ -6,15 +6,25 @@
 #include <mutex>
 #include <condition_variable>
 #include <fstream>
+#include <optional>
 #include "context.h"
 #include "../game/referee.h"
 #include "../net/api_client.h"
+#include "../sys/reactor.h"
+#include "eval_service.h"
+#include "scheduler.h"
+#include "../stats/queue_wait.h"
 
 namespace Arena::App {
 
+    struct ReadyGame {
+        std::shared_ptr<Game::Referee> game;
+        std::chrono::steady_clock::time_point since;
+        std::optional<std::chrono::steady_clock::time_point> ready{};
+    };
+
     struct WorkerState {
-        std::deque<EvalJob>& eval_queue;
-        std::deque<std::shared_ptr<Game::Referee>>& game_queue;
+        std::deque<ReadyGame>& game_queue;
         std::deque<GameParams>& global_game_queue;
         std::mutex& task_mtx;
         std::condition_variable& task_cv;
@@ -24,10 +34,23 @@ namespace Arena::App {
         const Core::BatchConfig& bc;
         std::ofstream& ndjson_out;
         std::mutex& ndjson_mtx;
+        Sys::Reactor* reactor = nullptr;
+        std::shared_ptr<Sys::ProcessPool> pool;
+        int prespawn_depth = 0;
+        EvalService* evals = nullptr;
+        Stats::QueueWait* play_wait = nullptr;
+        std::shared_ptr<Sys::CoreAllocator> cores;
+        Scheduler* scheduler = nullptr;
     };
 
     void interleaved_worker_loop(const Core::Config& cfg, WorkerState& ws);
 
+    void finalize_run(
+        std::shared_ptr<RunContext> ctx, const Core::BatchConfig& bc,
+        std::ofstream& ndjson_out, std::mutex& ndjson_mtx,
+        std::shared_ptr<Net::ApiManager> api
+    );
+
     std::string format_ndjson_line(
         const Core::BatchConfig& bc, const Core::RunSpec& rs, const MatchState& state,
         const Stats::Tracker& stats, double duration, double arena_load,
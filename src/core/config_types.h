@@ -3,8 +3,10 @@
 #include <string>
 #include <vector>
 #include <optional>
+#include <utility>
 #include <algorithm>
 #include "constants.h"
+#include "types.h"
 
 namespace Arena::Core {
     inline bool is_rapfi_bot(const std::string& name_or_cmd) {
@@ -22,6 +24,7 @@ namespace Arena::Core {
         int timeout_cutoff = 0;
         int timeout_game = 0;
         uint64_t max_nodes = 0;
+        std::vector<std::pair<std::string, std::string>> info{};
 
         void calculate_timeout(const std::string& bot_name) {
             if (timeout_cutoff != 0) return;
@@ -39,20 +42,35 @@ namespace Arena::Core {
         }
     };
 
+    enum class Tournament { NONE, GAUNTLET, ROUND_ROBIN };
+
+    struct SprtConfig {
+        bool enabled = false;
+        double elo0 = Constants::DEFAULT_SPRT_ELO0;
+        double elo1 = Constants::DEFAULT_SPRT_ELO1;
+        double alpha = Constants::DEFAULT_SPRT_ALPHA;
+        double beta = Constants::DEFAULT_SPRT_BETA;
+    };
+
     struct RunSpec {
         uint64_t p1_nodes = 0, p2_nodes = 0;
         uint64_t eval_nodes = Constants::DEFAULT_EVAL_NODES;
         int min_pairs = 1, max_pairs = 10;
         int repeat_index = 0;
+        int p1_engine = 0, p2_engine = 1;
         std::optional<uint64_t> seed;
     };
 
     struct BatchConfig {
         std::string p1_cmd, p2_cmd, eval_cmd;
+        std::vector<std::string> engines;
+        Tournament tournament = Tournament::NONE;
         int board_size = Constants::DEFAULT_BOARD_SIZE;
+        Rule rule = Rule::FREESTYLE;
         std::string openings_path;
         bool shuffle_openings = false;
         int threads = Constants::DEFAULT_THREADS;
+        int concurrency = 0;
 
         int p1_timeout_announce = Constants::DEFAULT_TIMEOUT_TURN_MS;
         int p2_timeout_announce = Constants::DEFAULT_TIMEOUT_TURN_MS;
@@ -61,19 +79,44 @@ namespace Arena::Core {
         int eval_timeout_cutoff = Constants::DEFAULT_EVAL_CUTOFF_MS;
 
         long long p1_memory = 0, p2_memory = 0;
+        std::string cgroup;
+        double cgroup_cpus = 0;
+        std::string cgroup_cpuset;
 
         std::vector<uint64_t> common_nodes_list;
         std::vector<uint64_t> p1_nodes_list, p2_nodes_list, eval_nodes_list;
         std::vector<int> min_pairs_list, max_pairs_list;
         std::vector<uint64_t> seeds;
         int repeat = 1;
+        bool adaptive = false;
+        int budget = 0;
+        std::string tune_path, tune_checkpoint;
 
         double risk = Constants::DEFAULT_RISK;
+        SprtConfig sprt;
         std::string api_url, api_key;
         int debounce_ms = 0;
         std::string export_results;
+        std::string journal;
+        bool resume = false;
         bool debug = false, show_board = false;
         bool cleanup = false, exit_on_crash = false;
+        bool reuse_engines = false;
+        int prespawn = 0;
+        bool pin = false, oversubscribe = false;
+
+        int eval_procs = 0;
+        int eval_queue = Constants::EVAL_QUEUE_MAX;
+        int eval_idle_ms = Constants::EVAL_IDLE_SHUTDOWN_MS;
+        std::vector<int> eval_cpus;
+        bool eval_whole_game = false;
+        std::string eval_cache;
+        size_t eval_cache_size = Constants::CACHE_DEFAULT_SIZE;
+
+        const std::string& engine_cmd(int i) const {
+            if (!engines.empty()) return engines[i];
+            return i == 0 ? p1_cmd : p2_cmd;
+        }
     };
 
     struct Config {
@@ -82,13 +125,16 @@ namespace Arena::Core {
         std::string eval_path;
         int eval_timeout_cutoff = Constants::DEFAULT_EVAL_CUTOFF_MS;
         int board_size = Constants::DEFAULT_BOARD_SIZE;
+        Rule rule = Rule::FREESTYLE;
         bool use_openings = false;
         std::string openings_path;
         bool shuffle_openings = false;
         int threads = Constants::DEFAULT_THREADS;
+        int concurrency = Constants::DEFAULT_THREADS;
         int max_pairs = Constants::DEFAULT_MAX_PAIRS;
         int min_pairs = Constants::DEFAULT_MIN_PAIRS;
         double risk = Constants::DEFAULT_RISK;
+        SprtConfig sprt;
         bool debug = false;
         bool show_board = false;
         bool cleanup = false;
@@ -14,11 +14,32 @@ namespace Arena::Core::Constants {
     constexpr int EXIT_CODE_EXEC_FAILED = 127;
 
     constexpr int DEFAULT_BOARD_SIZE = 20;
+    constexpr int MIN_BOARD_SIZE = 5;
+    constexpr int MAX_BOARD_SIZE = 40;
     constexpr int WINNING_LENGTH = 5;
 
     constexpr int DEFAULT_MIN_PAIRS = 1;
     constexpr int DEFAULT_MAX_PAIRS = 50;
     constexpr double DEFAULT_RISK = 0.0;
+    constexpr double DEFAULT_SPRT_ELO0 = 0.0;
+    constexpr double DEFAULT_SPRT_ELO1 = 5.0;
+    constexpr double DEFAULT_SPRT_ALPHA = 0.05;
+    constexpr double DEFAULT_SPRT_BETA = 0.05;
+    constexpr double SPRT_PENTA_PRIOR = 1e-3;
+    constexpr int SPRT_BISECT_ITERATIONS = 100;
+    constexpr double RACE_CONFIDENCE_Z = 2.576;
+    constexpr double RACE_ALPHA = 0.01;
+    constexpr double RACE_PENTA_PRIOR = 0.5;
+    constexpr double BT_PRIOR_DRAWS = 1.0;
+    constexpr double BT_TOLERANCE = 1e-10;
+    constexpr int BT_MAX_ITERATIONS = 10000;
+    constexpr double BT_CONFIDENCE_Z = 1.96;
+    constexpr double SPSA_ALPHA = 0.602;
+    constexpr double SPSA_GAMMA = 0.101;
+    constexpr double SPSA_A_RATIO = 0.1;
+    constexpr int SPSA_CHECKPOINT_PAIRS = 16;
+    constexpr int JOURNAL_SYNC_RECORDS = 64;
+    constexpr int JOURNAL_SYNC_MS = 1000;
 
     constexpr int DEFAULT_TIMEOUT_TURN_MS = 5000;
     constexpr int MIN_TURN_TIMEOUT_MS = 10;
@@ -26,7 +47,10 @@ namespace Arena::Core::Constants {
     constexpr int POLL_TIMEOUT_MS = 100;
     constexpr int WRITE_TIMEOUT_MS = 500;
     constexpr int TERMINATION_GRACE_MS = 100;
+    constexpr long CGROUP_CPU_PERIOD_US = 100000;
+    constexpr long CGROUP_CPU_MIN_QUOTA_US = 1000;
     constexpr int WORKER_IDLE_WAIT_MS = 500;
+    constexpr int REACTOR_MAX_EVENTS = 64;
     constexpr int PROGRESS_LOG_INTERVAL_MS = 5000;
 
     constexpr int ELO_BASE = 1000;
@@ -46,6 +70,11 @@ namespace Arena::Core::Constants {
 
     constexpr uint64_t DEFAULT_EVAL_NODES = 2000000;
     constexpr int DEFAULT_EVAL_CUTOFF_MS = 30000;
+    constexpr size_t EVAL_QUEUE_MAX = 4096;
+    constexpr size_t EVAL_BATCH_MAX = 8;
+    constexpr size_t EVAL_AFFINITY_SCAN = 32;
+    constexpr int EVAL_STEAL_MS = 100;
+    constexpr int EVAL_IDLE_SHUTDOWN_MS = 30000;
     constexpr double METRIC_CRITICAL_SHARPNESS = 0.05;
     constexpr double METRIC_CRITICAL_SUCCESS_REGRET = 0.02;
     constexpr double METRIC_SEVERE_ERROR_REGRET = 0.20;
@@ -65,13 +94,16 @@ namespace Arena::Core::Constants {
     constexpr uint64_t ZOBRIST_SEED = 12345;
     constexpr long long PROCESS_MEMORY_OVERHEAD = 128 * 1048576;
     constexpr size_t PROCESS_BUFFER_MAX = 262144;
-    constexpr size_t CACHE_MAX_SIZE = 1048576;
+    constexpr size_t CACHE_DEFAULT_SIZE = 1048576;
+    constexpr size_t CACHE_BUCKET_WAYS = 4;
+    constexpr int CACHE_READ_RETRIES = 64;
+    constexpr uint32_t CACHE_FILE_VERSION = 3;
     constexpr size_t READ_BUFFER_SIZE = 4096;
     constexpr int PATH_BUFFER_SIZE = 64;
     constexpr int PROC_STAT_BUFFER_SIZE = 4096;
 
     constexpr int EXIT_CHECK_INTERVAL_MS = 2;
-    constexpr int EXIT_CHECK_RETRIES = 5;
+    constexpr int EXIT_CHECK_TIMEOUT_MS = 10;
     constexpr int PROC_STAT_FIELD_COUNT_MIN = 4;
     constexpr int PROC_STAT_FIELD_COUNT_MAX = 15;
     constexpr int PROC_UTIME_FIELD = 14;
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+#include "types.h"
+
+namespace Arena::Core {
+    class GameRecord {
+    public:
+        explicit GameRecord(size_t capacity)
+            : moves_(new Move[capacity]), capacity_(capacity) {}
+
+        static std::shared_ptr<GameRecord> for_board(int board_size) {
+            return std::make_shared<GameRecord>((size_t)board_size * board_size);
+        }
+
+        void push(Point p) {
+            size_t n = size_.load(std::memory_order_relaxed);
+            if (n >= capacity_) throw std::length_error("Game record full");
+            moves_[n] = {(uint8_t)p.x, (uint8_t)p.y};
+            size_.store(n + 1, std::memory_order_release);
+        }
+
+        Point operator[](size_t i) const { return {moves_[i].x, moves_[i].y}; }
+        size_t size() const { return size_.load(std::memory_order_acquire); }
+        size_t capacity() const { return capacity_; }
+
+    private:
+        struct Move {
+            uint8_t x, y;
+        };
+
+        std::unique_ptr<Move[]> moves_;
+        size_t capacity_;
+        std::atomic<size_t> size_{0};
+    };
+
+    class MoveList {
+    public:
+        MoveList() = default;
+        MoveList(std::shared_ptr<const GameRecord> rec, size_t ply)
+            : rec_(std::move(rec)), ply_(ply) {}
+        MoveList(const std::vector<Point>& moves) : MoveList(copy(moves.begin(), moves.end())) {}
+        MoveList(std::initializer_list<Point> moves) : MoveList(copy(moves.begin(), moves.end())) {}
+
+        size_t size() const { return ply_; }
+        bool empty() const { return ply_ == 0; }
+        Point operator[](size_t i) const { return (*rec_)[i]; }
+        Point back() const { return (*rec_)[ply_ - 1]; }
+        MoveList prefix(size_t ply) const { return {rec_, ply < ply_ ? ply : ply_}; }
+        const std::shared_ptr<const GameRecord>& record() const { return rec_; }
+
+        std::vector<Point> to_vector(size_t count) const {
+            std::vector<Point> v;
+            v.reserve(count);
+            for (size_t i = 0; i < count && i < ply_; ++i) v.push_back((*rec_)[i]);
+            return v;
+        }
+        std::vector<Point> to_vector() const { return to_vector(ply_); }
+
+    private:
+        template <typename It>
+        static MoveList copy(It first, It last) {
+            auto rec = std::make_shared<GameRecord>((size_t)(last - first));
+            for (; first != last; ++first) rec->push(*first);
+            size_t n = rec->size();
+            return {std::move(rec), n};
+        }
+
+        std::shared_ptr<const GameRecord> rec_;
+        size_t ply_ = 0;
+    };
+}
@@ -6,10 +6,12 @@
 namespace Arena::Core {
     enum class PlayerColor { NONE = 0, BLACK = 1, WHITE = 2 };
     enum class Winner { NONE = 0, P1 = 1, P2 = 2, DRAW = 3 };
+    enum class Rule { FREESTYLE = 0, STANDARD = 1, RENJU = 4 };
 
     struct Point {
         int x;
         int y;
+        bool operator==(const Point& o) const { return x == o.x && y == o.y; }
     };
 
     struct MatchTerminated : public std::runtime_error {
@@ -40,6 +40,12 @@ namespace Arena::Core::Utils {
         return result;
     }
 
+    inline std::string command_name(const std::string& cmd) {
+        size_t end = cmd.find(' ');
+        size_t slash = cmd.rfind('/', end);
+        return slash == std::string::npos ? cmd : cmd.substr(slash + 1);
+    }
+
     inline int parse_duration_ms(const std::string& s) {
         size_t idx = 0;
         double val = std::stod(s, &idx);
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "../core/constants.h"
+#include "../core/types.h"
+
+namespace Arena::Game {
+    class Bitboard {
+    public:
+        static constexpr int MAX = Core::Constants::MAX_BOARD_SIZE;
+        static constexpr int DIAGS = 2 * MAX - 1;
+        enum Direction { ROW, COLUMN, DIAGONAL, ANTI_DIAGONAL, DIRECTIONS };
+
+        explicit Bitboard(int size) : size_(size) {}
+
+        int size() const { return size_; }
+
+        int at(int x, int y) const {
+            uint64_t bit = 1ULL << x;
+            if (lines_[0].rows[y] & bit) return 1;
+            if (lines_[1].rows[y] & bit) return 2;
+            return 0;
+        }
+
+        bool occupied(int x, int y) const {
+            return (lines_[0].rows[y] | lines_[1].rows[y]) >> x & 1;
+        }
+
+        void place(int x, int y, int c) {
+            Lines& l = lines_[c - 1];
+            l.rows[y] |= 1ULL << x;
+            l.cols[x] |= 1ULL << y;
+            l.diag[x - y + MAX - 1] |= 1ULL << x;
+            l.anti[x + y] |= 1ULL << x;
+        }
+
+        void remove(int x, int y, int c) {
+            Lines& l = lines_[c - 1];
+            l.rows[y] &= ~(1ULL << x);
+            l.cols[x] &= ~(1ULL << y);
+            l.diag[x - y + MAX - 1] &= ~(1ULL << x);
+            l.anti[x + y] &= ~(1ULL << x);
+        }
+
+        uint64_t span(Direction d, int x, int y) const {
+            int lo = 0, hi = size_ - 1;
+            if (d == DIAGONAL) {
+                lo = x - y > 0 ? x - y : 0;
+                hi = size_ - 1 + (x - y < 0 ? x - y : 0);
+            } else if (d == ANTI_DIAGONAL) {
+                lo = x + y - (size_ - 1) > 0 ? x + y - (size_ - 1) : 0;
+                hi = x + y < size_ - 1 ? x + y : size_ - 1;
+            }
+            return ((2ULL << hi) - 1) & ~((1ULL << lo) - 1);
+        }
+
+        static Core::Point point(Direction d, int x, int y, int pos) {
+            switch (d) {
+                case COLUMN: return {x, pos};
+                case DIAGONAL: return {pos, pos - (x - y)};
+                case ANTI_DIAGONAL: return {pos, x + y - pos};
+                default: return {pos, y};
+            }
+        }
+
+        uint64_t line(Direction d, int x, int y, int c, int& pos) const {
+            const Lines& l = lines_[c - 1];
+            switch (d) {
+                case COLUMN: pos = y; return l.cols[x];
+                case DIAGONAL: pos = x; return l.diag[x - y + MAX - 1];
+                case ANTI_DIAGONAL: pos = x; return l.anti[x + y];
+                default: pos = x; return l.rows[y];
+            }
+        }
+
+    private:
+        struct Lines {
+            std::array<uint64_t, MAX> rows{};
+            std::array<uint64_t, MAX> cols{};
+            std::array<uint64_t, DIAGS> diag{};
+            std::array<uint64_t, DIAGS> anti{};
+        };
+
+        int size_;
+        std::array<Lines, 2> lines_{};
+    };
+}
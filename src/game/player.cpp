@@ -22,6 +22,41 @@ namespace Arena::Game {
         return proc_->start(mem, env_vars);
     }
 
+    void Player::adopt(std::unique_ptr<Sys::Process> proc) {
+        proc_ = proc ? std::move(proc) : std::make_unique<Sys::Process>(path_);
+    }
+
+    std::unique_ptr<Sys::Process> Player::detach() {
+        auto proc = std::move(proc_);
+        proc_ = std::make_unique<Sys::Process>(path_);
+        return proc;
+    }
+
+    void Player::retire(Sys::Reactor* reactor) {
+        if (reactor && proc_->exit_fd() >= 0)
+            Sys::Process::retire(detach(), *reactor);
+        else
+            stop();
+    }
+
+    bool Player::restart() {
+        try {
+            send("RESTART");
+            while (auto line = proc_->read_line(
+                Core::Constants::META_TIMEOUT_MS, nullptr))
+            {
+                if (is_message_or_debug(*line)) continue;
+                return *line == "OK";
+            }
+        } catch (const std::exception& e) {
+            Core::Logger::log(
+                Core::Logger::Level::DEBUG,
+                id_, " RESTART failed: ", e.what()
+            );
+        }
+        return false;
+    }
+
     void Player::send(const std::string& cmd) {
         Core::Logger::log(
             Core::Logger::Level::DEBUG, "-> ", id_, ": ", cmd
@@ -72,10 +107,34 @@ namespace Arena::Game {
         }
     }
 
+    std::optional<std::string> Player::poll() {
+        while (auto line = proc_->poll_line()) {
+            if (is_message_or_debug(*line)) {
+                Core::Logger::log(
+                    Core::Logger::Level::INFO,
+                    id_, " says: ", *line
+                );
+                continue;
+            }
+            if (line->rfind("UNKNOWN", 0) == 0) {
+                Core::Logger::log(
+                    Core::Logger::Level::WARN,
+                    id_, " UNKNOWN cmd: ", *line
+                );
+                continue;
+            }
+            return line;
+        }
+        return std::nullopt;
+    }
+
     void Player::meta() {
         send("ABOUT");
         long ign = 0;
-        std::string s = read(Core::Constants::META_TIMEOUT_MS, ign);
+        parse_meta(read(Core::Constants::META_TIMEOUT_MS, ign));
+    }
+
+    void Player::parse_meta(const std::string& s) {
         extract_name(s);
         extract_version(s);
     }
@@ -12,14 +12,23 @@ namespace Arena::Game {
         bool start(long long mem, const std::map<std::string,
             std::string>& env_vars = {});
         void stop() { proc_->terminate(); }
+        void retire(Sys::Reactor* reactor);
+        void adopt(std::unique_ptr<Sys::Process> proc);
+        std::unique_ptr<Sys::Process> detach();
+        bool restart();
         long peak_mem() const { return proc_->get_peak_mem(); }
         long current_rss_kb() const { return proc_->get_current_rss_kb(); }
+        long peak_rss_kb() const { return proc_->get_peak_rss_kb(); }
+        long long cpu_ns() const { return proc_->get_cpu_ns(); }
         std::string name() const { return name_; }
         std::string version() const { return version_; }
         pid_t pid() const { return proc_->pid(); }
+        int fd() const { return proc_->out_fd_; }
         void send(const std::string& cmd);
         std::string read(int timeout, long& elapsed);
+        std::optional<std::string> poll();
         void meta();
+        void parse_meta(const std::string& s);
 
     private:
         bool is_message_or_debug(const std::string& s);
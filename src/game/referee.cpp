@@ -1,8 +1,8 @@
 #include "referee.h"
 #include "rules.h"
 #include "../core/logger.h"
-#include "../sys/cpu_monitor.h"
 #include "../sys/signals.h"
+#include <iomanip>
 
 namespace Arena::Game {
 
@@ -16,7 +16,10 @@ Referee::Referee(
     p_(p), api_(api), stats_(st), cb_(cb),
     pl1_(p.p1_cfg.cmd, "P1", p.create_process(p.p1_cfg.cmd)),
     pl2_(p.p2_cfg.cmd, "P2", p.create_process(p.p2_cfg.cmd)),
-    board_(p.config().board_size * p.config().board_size, 0),
+    board_(p.config().board_size),
+    judge_(Rules::judge_for(p.config().rule)),
+    hist_(Core::GameRecord::for_board(p.config().board_size)),
+    sym_(p.config().board_size),
     time_p1_(p.p1_cfg.timeout_game),
     time_p2_(p.p2_cfg.timeout_game)
 {}
@@ -25,12 +28,12 @@ Referee::~Referee() {
     if (start_sent_ && !result_sent_) {
         try { send_result_event(0.5); } catch (...) {}
     }
-    pl1_.stop();
-    pl2_.stop();
+    pl1_.retire(p_.reactor);
+    pl2_.retire(p_.reactor);
 }
 
-Referee::Status Referee::step(std::vector<Core::Point>& out_history) {
-    try {
+Referee::Status Referee::step(Core::MoveList& out_history) {
+    return guarded([&] {
         if (state_ == State::UNINITIALIZED) {
             initialize_game(out_history);
             return Status::RUNNING;
@@ -38,7 +41,47 @@ Referee::Status Referee::step(std::vector<Core::Point>& out_history) {
 
         if (play_turn(out_history)) return Status::FINISHED;
         return Status::RUNNING;
+    });
+}
+
+Referee::Status Referee::step_async(
+    Core::MoveList& out_history,
+    std::optional<std::chrono::steady_clock::time_point> ready
+) {
+    return guarded([&] {
+        if (state_ == State::UNINITIALIZED) begin_handshake(true);
+        if (state_ == State::HANDSHAKE) {
+            auto arrived = std::chrono::steady_clock::now();
+            if (ready) arrived = std::min(arrived, *ready);
+            if (!poll_handshake(arrived)) return Status::WAITING;
+            finish_handshake(out_history);
+            return Status::RUNNING;
+        }
+
+        if (!turn_) {
+            if (board_full()) {
+                finish(0.5);
+                return Status::FINISHED;
+            }
+            begin_turn();
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        if (ready && *ready > turn_->start) end = std::min(end, *ready);
+        auto r = poll_move(end);
+        if (!r) return Status::WAITING;
+
+        long el = std::chrono::duration_cast<std::chrono::milliseconds>(
+            end - turn_->start
+        ).count();
+        if (complete_turn(*r, el, out_history, end)) return Status::FINISHED;
+        return Status::RUNNING;
+    });
+}
 
+Referee::Status Referee::guarded(const std::function<Status()>& fn) {
+    try {
+        return fn();
     } catch (const Core::PlayerError& e) {
         Core::Logger::log(
             Core::Logger::Level::WARN,
@@ -54,10 +97,12 @@ Referee::Status Referee::step(std::vector<Core::Point>& out_history) {
             throw Core::MatchTerminated();
         }
         Core::PlayerColor loser = current_player();
+        faulted_ = loser;
         finish(loser == Core::PlayerColor::BLACK ? 0.0 : 1.0);
         return Status::FINISHED;
     } catch (const Core::MatchTerminated&) {
-        if (state_ == State::INITIALIZED) finish(0.5);
+        reusable_ = false;
+        if (state_ != State::UNINITIALIZED) finish(0.5);
         else { pl1_.stop(); pl2_.stop(); }
         throw;
     } catch (const std::exception& e) {
@@ -75,7 +120,9 @@ Referee::Status Referee::step(std::vector<Core::Point>& out_history) {
             throw Core::MatchTerminated();
         }
         Core::PlayerColor crash_p = current_player();
+        faulted_ = crash_p;
         stats_.add_crash(crash_p == Core::PlayerColor::BLACK ? 1 : 2);
+        if (p_.tally) p_.tally->stats.add_crash(crash_p == Core::PlayerColor::BLACK ? 1 : 2);
         finish(crash_p == Core::PlayerColor::BLACK ? 0.0 : 1.0);
         return Status::FINISHED;
     }
@@ -95,42 +142,134 @@ Core::PlayerColor Referee::current_player() const {
         : Core::PlayerColor::WHITE;
 }
 
-void Referee::initialize_game(std::vector<Core::Point>& out_history) {
-    state_ = State::INITIALIZED;
-    if (auto ctx = p_.context) send_run_start_event_if_needed(ctx);
+void Referee::initialize_game(Core::MoveList& out_history) {
+    begin_handshake(false);
+    while (!replies_.empty()) {
+        const auto& r = replies_.front();
+        long e = 0;
+        std::string line = r.player->read(r.limit_ms, e);
+        accept_reply(line, std::chrono::steady_clock::now());
+    }
+    finish_handshake(out_history);
+}
 
-    std::map<std::string, std::string> env_vars;
-    if (p_.seed) env_vars["GOMOKU_SEED"] = std::to_string(*p_.seed);
+void Referee::begin_handshake(bool pipeline) {
+    state_ = State::HANDSHAKE;
+    if (auto ctx = p_.context) send_run_start_event_if_needed(ctx);
 
-    long long mem1 = p_.p1_cfg.memory;
-    if (mem1 > 0 && Core::is_rapfi_bot(p_.p1_cfg.cmd))
-        mem1 += Core::Constants::PROCESS_MEMORY_OVERHEAD;
+    auto env_vars = p_.spawn_env();
+    long long mem1 = p_.spawn_memory(p_.p1_cfg);
+    long long mem2 = p_.spawn_memory(p_.p2_cfg);
 
-    long long mem2 = p_.p2_cfg.memory;
-    if (mem2 > 0 && Core::is_rapfi_bot(p_.p2_cfg.cmd))
-        mem2 += Core::Constants::PROCESS_MEMORY_OVERHEAD;
+    bool warm1 = acquire_warm(pl1_, p_.p1_cfg);
+    bool warm2 = acquire_warm(pl2_, p_.p2_cfg);
 
-    if (!pl1_.start(mem1, env_vars))
+    if (!warm1 && !pl1_.start(mem1, env_vars))
         throw std::runtime_error("P1 start failed");
-    if (!pl2_.start(mem2, env_vars))
+    if (!warm2 && !pl2_.start(mem2, env_vars))
         throw std::runtime_error("P2 start failed");
+    pin(pl1_, 0);
+    pin(pl2_, 1);
+
+    std::string start = "START " + std::to_string(p_.config().board_size);
+    replies_.push_back({&pl1_, &p_.p1_cfg, "ABOUT", true});
+    replies_.push_back({&pl2_, &p_.p2_cfg, "ABOUT", true});
+    if (!warm1) replies_.push_back({&pl1_, &p_.p1_cfg, start, false});
+    if (!warm2) replies_.push_back({&pl2_, &p_.p2_cfg, start, false});
+
+    if (pipeline) {
+        for (auto& r : replies_) {
+            r.player->send(r.cmd);
+            r.sent = true;
+        }
+    }
+    expect_reply(std::chrono::steady_clock::now());
+}
 
-    pl1_.meta();
-    pl2_.meta();
-    send_start_event();
-    init_player(pl1_, p_.p1_cfg);
-    init_player(pl2_, p_.p2_cfg);
+void Referee::expect_reply(std::chrono::steady_clock::time_point from) {
+    if (!named_ && (replies_.empty() || !replies_.front().about)) {
+        named_ = true;
+        p_.p1_cfg.calculate_timeout(pl1_.name());
+        p_.p2_cfg.calculate_timeout(pl2_.name());
+        send_start_event();
+    }
+    if (replies_.empty()) return;
+
+    auto& r = replies_.front();
+    if (!r.sent) {
+        r.player->send(r.cmd);
+        r.sent = true;
+    }
+    r.limit_ms = r.about
+        ? Core::Constants::META_TIMEOUT_MS
+        : r.cfg->timeout_cutoff;
+    r.deadline = from + std::chrono::milliseconds(r.limit_ms);
+}
+
+void Referee::accept_reply(
+    const std::string& line, std::chrono::steady_clock::time_point arrived
+) {
+    PendingReply r = replies_.front();
+    replies_.pop_front();
+    if (r.about) r.player->parse_meta(line);
+    else if (line != "OK") throw Core::PlayerError("Expected OK");
+    expect_reply(arrived);
+}
+
+bool Referee::poll_handshake(std::chrono::steady_clock::time_point arrived) {
+    while (!replies_.empty()) {
+        if (arrived >= replies_.front().deadline)
+            throw Core::PlayerError("Timeout");
+        auto line = replies_.front().player->poll();
+        if (!line) return false;
+        accept_reply(*line, arrived);
+    }
+    return true;
+}
+
+void Referee::finish_handshake(Core::MoveList& out_history) {
+    send_info(pl1_, p_.p1_cfg);
+    send_info(pl2_, p_.p2_cfg);
     apply_opening_moves();
-    out_history = hist_;
+    out_history = history();
+    state_ = State::INITIALIZED;
 }
 
-void Referee::init_player(Player& p, Core::BotConfig& cfg) {
-    p.send("START " + std::to_string(p_.config().board_size));
-    cfg.calculate_timeout(p.name());
-    long e = 0;
-    if (p.read(cfg.timeout_cutoff, e) != "OK")
-        throw Core::PlayerError("Expected OK");
+void Referee::pin(Player& p, size_t slot) {
+    if (!p_.cores || slot >= p_.cores->size()) return;
+    const auto& cpus = p_.cores->cpus(slot);
+    if (!Sys::Affinity::pin_process(p.pid(), cpus)) {
+        Core::Logger::log(
+            Core::Logger::Level::WARN,
+            "Failed to pin ", p.name(), " to CPU ", cpus.front()
+        );
+    }
+}
+
+bool Referee::acquire_warm(Player& p, const Core::BotConfig& cfg) {
+    if (!p_.pool) return false;
+    std::string key = p_.pool_key(cfg);
+    bool primed = false;
+    auto proc = p_.pool->acquire(key, &primed);
+    if (!proc) {
+        p_.pool->record_spawn();
+        return false;
+    }
+
+    p.adopt(std::move(proc));
+    if (primed || p.restart()) return true;
 
+    Core::Logger::log(
+        Core::Logger::Level::WARN,
+        "Bot ", cfg.cmd, " does not support RESTART, disabling reuse"
+    );
+    p_.pool->mark_unsupported(key);
+    p_.pool->record_spawn();
+    p.adopt(p_.create_process(cfg.cmd));
+    return false;
+}
+
+void Referee::send_info(Player& p, const Core::BotConfig& cfg) {
     if (cfg.max_nodes > 0) {
         p.send("INFO MAX_NODE " + std::to_string(cfg.max_nodes));
         p.send("INFO timeout_turn 0");
@@ -141,35 +280,53 @@ void Referee::init_player(Player& p, Core::BotConfig& cfg) {
     }
     p.send("INFO max_memory " + std::to_string(cfg.memory));
     p.send("INFO game_type 1");
-    p.send("INFO rule 0");
+    p.send("INFO rule " + std::to_string(static_cast<int>(p_.config().rule)));
     p.send("INFO THREAD_NUM 1");
+    for (const auto& [name, value] : cfg.info)
+        p.send("INFO " + name + " " + value);
 }
 
-bool Referee::play_turn(std::vector<Core::Point>& out_history) {
-    if (moves_ >= p_.config().board_size * p_.config().board_size) {
+bool Referee::play_turn(Core::MoveList& out_history) {
+    if (board_full()) {
         finish(0.5);
         return true;
     }
 
-    Core::PlayerColor c = current_player();
-    Player* cp = (c == Core::PlayerColor::BLACK)
-        ? &pl1_ : &pl2_;
-    int& time_bank = (c == Core::PlayerColor::BLACK)
-        ? time_p1_ : time_p2_;
-    int turn_lim = (c == Core::PlayerColor::BLACK)
+    begin_turn();
+    long el = 0;
+    std::string r = await_move(el);
+    return complete_turn(r, el, out_history, std::chrono::steady_clock::now());
+}
+
+bool Referee::board_full() const {
+    return moves_ >= p_.config().board_size * p_.config().board_size;
+}
+
+void Referee::begin_turn() {
+    PendingTurn t;
+    t.color = current_player();
+    t.player = (t.color == Core::PlayerColor::BLACK) ? &pl1_ : &pl2_;
+    t.limit_ms = (t.color == Core::PlayerColor::BLACK)
         ? p_.p1_cfg.timeout_cutoff : p_.p2_cfg.timeout_cutoff;
+    int time_bank = (t.color == Core::PlayerColor::BLACK)
+        ? time_p1_ : time_p2_;
 
     if (time_bank > 0)
-        cp->send("INFO time_left " + std::to_string(time_bank));
-    auto cpu_start = Sys::CpuMonitor::get_times(cp->pid());
-    send_turn_command(cp);
+        t.player->send("INFO time_left " + std::to_string(time_bank));
+    t.cpu_start_ns = t.player->cpu_ns();
+    send_turn_command(t.player);
+    t.start = std::chrono::steady_clock::now();
+    t.deadline = t.start + std::chrono::milliseconds(t.limit_ms);
+    turn_ = t;
+}
 
-    long el = 0;
+std::string Referee::await_move(long& elapsed) {
+    int turn_lim = turn_->limit_ms;
     std::string r;
     while (true) {
         long local_el = 0;
-        r = cp->read(turn_lim, local_el);
-        el += local_el;
+        r = turn_->player->read(turn_lim, local_el);
+        elapsed += local_el;
         if (r == "OK") {
             turn_lim = std::max(
                 Core::Constants::MIN_TURN_TIMEOUT_MS,
@@ -177,81 +334,139 @@ bool Referee::play_turn(std::vector<Core::Point>& out_history) {
             );
             continue;
         }
-        break;
+        return r;
+    }
+}
+
+std::optional<std::string> Referee::poll_move(
+    std::chrono::steady_clock::time_point arrived
+) {
+    if (arrived >= turn_->deadline) throw Core::PlayerError("Timeout");
+    while (auto r = turn_->player->poll()) {
+        if (*r != "OK") return r;
+        turn_->deadline = std::max(
+            turn_->deadline,
+            arrived + std::chrono::milliseconds(Core::Constants::MIN_TURN_TIMEOUT_MS)
+        );
     }
+    return std::nullopt;
+}
+
+bool Referee::complete_turn(
+    const std::string& r, long el, Core::MoveList& out_history,
+    std::chrono::steady_clock::time_point end
+) {
+    PendingTurn t = *turn_;
+    turn_.reset();
+
+    Core::PlayerColor c = t.color;
+    Player* cp = t.player;
+    int& time_bank = (c == Core::PlayerColor::BLACK)
+        ? time_p1_ : time_p2_;
 
     if (time_bank > 0 && (time_bank -= static_cast<int>(el)) < 0)
         throw Core::PlayerError("Game timeout");
 
     auto move = parse_and_validate_move(r);
     apply_move(move);
-    out_history = hist_;
+    out_history = history();
 
-    auto cpu_end = Sys::CpuMonitor::get_times(cp->pid());
-    long cpu_delta = (cpu_end.user_ms - cpu_start.user_ms) +
-        (cpu_end.sys_ms - cpu_start.sys_ms);
+    long long cpu_ns = std::max(0LL, cp->cpu_ns() - t.cpu_start_ns);
+    long long wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        end - t.start
+    ).count();
 
     if (c == Core::PlayerColor::BLACK) {
-        p1_cpu_ms_ += cpu_delta;
+        p1_cpu_ns_ += cpu_ns;
         if (p_.context) {
-            p_.context->total_p1_cpu += cpu_delta;
-            p_.context->total_p1_wall += el;
+            p_.context->total_p1_cpu_ns += cpu_ns;
+            p_.context->total_p1_wall_ns += wall_ns;
         }
     } else {
-        p2_cpu_ms_ += cpu_delta;
+        p2_cpu_ns_ += cpu_ns;
         if (p_.context) {
-            p_.context->total_p2_cpu += cpu_delta;
-            p_.context->total_p2_wall += el;
+            p_.context->total_p2_cpu_ns += cpu_ns;
+            p_.context->total_p2_wall_ns += wall_ns;
         }
     }
 
     if (p_.config().debug) {
-        double load_pct = Sys::CpuMonitor::calculate_load(
-            cpu_start, cpu_end, el
-        );
+        double load_pct = Sys::CpuMonitor::calculate_load(cpu_ns, wall_ns);
         Core::Logger::log(
             Core::Logger::Level::DEBUG,
             "Move ", moves_, " (",
             (c == Core::PlayerColor::BLACK ? "P1" : "P2"), "): ",
             move.x, ",", move.y, " | Wall: ", el, "ms | CPU: ",
-            cpu_delta, "ms | Load: ", (int)load_pct, "%"
+            std::fixed, std::setprecision(3), cpu_ns / 1e6,
+            "ms | Load: ", (int)load_pct, "%"
         );
     }
 
     if (p_.config().show_board) print_board();
 
-    if (Rules::check_win(board_, p_.config().board_size,
-        move.x, move.y, static_cast<int>(c))) {
+    auto verdict = judge_(board_, move.x, move.y, static_cast<int>(c));
+    if (verdict == Rules::Verdict::WIN) {
         finish((cp == &pl1_) ? 1.0 : 0.0);
         return true;
     }
+    if (verdict == Rules::Verdict::FORBIDDEN) {
+        Core::Logger::log(
+            Core::Logger::Level::INFO,
+            cp->name(), " played forbidden move ", move.x, ",", move.y
+        );
+        finish((cp == &pl1_) ? 0.0 : 1.0);
+        return true;
+    }
     return false;
 }
 
 void Referee::apply_move(const Core::Point& m) {
     Core::PlayerColor c = current_player();
-    board_[m.y * p_.config().board_size + m.x] = static_cast<int>(c);
-    hist_.push_back(m);
-    moves_++;
+    board_.place(m.x, m.y, static_cast<int>(c));
+    record_move(m);
     send_move_event(m, static_cast<int>(c));
 }
 
+void Referee::record_move(const Core::Point& m) {
+    keys_.push_back(sym_.key(m));
+    sym_.push(m);
+    hist_->push(m);
+    moves_++;
+}
+
 void Referee::finish(double res) {
     result_sent_ = true;
-    pl1_.stop();
-    pl2_.stop();
+    for (const auto& r : replies_)
+        if (r.sent) reusable_ = false;
+    long hwm1 = pl1_.peak_rss_kb();
+    long hwm2 = pl2_.peak_rss_kb();
+    release_or_stop(pl1_, p_.p1_cfg, faulted_ != Core::PlayerColor::BLACK);
+    release_or_stop(pl2_, p_.p2_cfg, faulted_ != Core::PlayerColor::WHITE);
 
     Core::Logger::log(
         Core::Logger::Level::INFO,
-        "Peak Memory: P1=", pl1_.peak_mem(),
-        "KB P2=", pl2_.peak_mem(), "KB"
+        "Peak Memory: P1=", std::max(pl1_.peak_mem(), hwm1),
+        "KB P2=", std::max(pl2_.peak_mem(), hwm2), "KB"
     );
 
     send_result_event(res);
     auto wall_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::steady_clock::now() - wall_start_
     ).count();
-    cb_(p_.pair, p_.leg, res, wall_ms, p1_cpu_ms_, p2_cpu_ms_);
+    cb_(p_.pair, p_.leg, res, wall_ms,
+        (long)(p1_cpu_ns_ / 1000000), (long)(p2_cpu_ns_ / 1000000));
+}
+
+void Referee::release_or_stop(
+    Player& p, const Core::BotConfig& cfg, bool healthy
+) {
+    bool fits = cfg.memory <= 0 || p.current_rss_kb() * 1024 < cfg.memory;
+    if (p_.pool && p_.pool->reuse() && reusable_ && healthy && fits &&
+        p.pid() > 0) {
+        p_.pool->release(p_.pool_key(cfg), p.detach());
+        return;
+    }
+    p.retire(p_.reactor);
 }
 
 void Referee::send_turn_command(Player* cp) {
@@ -259,9 +474,10 @@ void Referee::send_turn_command(Player* cp) {
         if (moves_ > 0) send_board_state(cp);
         else cp->send("BEGIN");
     } else {
+        Core::Point last = history().back();
         cp->send(
-            "TURN " + std::to_string(hist_.back().x) +
-            "," + std::to_string(hist_.back().y)
+            "TURN " + std::to_string(last.x) +
+            "," + std::to_string(last.y)
         );
     }
 }
@@ -269,8 +485,9 @@ void Referee::send_turn_command(Player* cp) {
 void Referee::send_board_state(Player* cp) {
     std::stringstream ss;
     ss << "BOARD\n";
-    for (size_t i = 0; i < hist_.size(); ++i) {
-        ss << hist_[i].x << "," << hist_[i].y
+    for (size_t i = 0; i < hist_->size(); ++i) {
+        Core::Point m = (*hist_)[i];
+        ss << m.x << "," << m.y
            << "," << ((i % 2 == 0) ? 1 : 2) << "\n";
     }
     ss << "DONE";
@@ -285,7 +502,7 @@ Core::Point Referee::parse_and_validate_move(const std::string& r) {
         throw Core::PlayerError("Invalid move: " + r);
     if (x < 0 || x >= p_.config().board_size || y < 0 || y >= p_.config().board_size)
         throw Core::PlayerError("OOB");
-    if (board_[y * p_.config().board_size + x])
+    if (board_.occupied(x, y))
         throw Core::PlayerError("Occupied");
     return {x, y};
 }
@@ -317,8 +534,8 @@ void Referee::apply_opening_moves() {
         Core::PlayerColor c = (moves_ % 2 == 0)
             ? Core::PlayerColor::BLACK
             : Core::PlayerColor::WHITE;
-        board_[m.y * p_.config().board_size + m.x] = static_cast<int>(c);
-        hist_.push_back(m); moves_++;
+        board_.place(m.x, m.y, static_cast<int>(c));
+        record_move(m);
         send_move_event(m, static_cast<int>(c));
     }
 }
@@ -327,7 +544,7 @@ void Referee::validate_opening_move(const Core::Point& m) {
     if (m.x < 0 || m.x >= p_.config().board_size ||
         m.y < 0 || m.y >= p_.config().board_size)
         throw std::runtime_error("OOB Opening");
-    if (board_[m.y * p_.config().board_size + m.x])
+    if (board_.occupied(m.x, m.y))
         throw std::runtime_error("Occupied Opening");
 }
 
@@ -351,9 +568,10 @@ void Referee::send_move_event(const Core::Point& m, int color) {
 void Referee::send_result_event(double res) {
     if (!api_ || !start_sent_) return;
     std::stringstream ss;
-    for (size_t i = 0; i < hist_.size(); ++i) {
+    for (size_t i = 0; i < hist_->size(); ++i) {
         if (i > 0) ss << ";";
-        ss << hist_[i].x << "," << hist_[i].y << "," << (i % 2 ? 2 : 1);
+        Core::Point m = (*hist_)[i];
+        ss << m.x << "," << m.y << "," << (i % 2 ? 2 : 1);
     }
     auto e = create_event("result");
     e.moves = ss.str();
@@ -378,7 +596,7 @@ void Referee::print_board() {
     ss << "\n";
     for (int y = 0; y < p_.config().board_size; ++y) {
         for (int x = 0; x < p_.config().board_size; ++x) {
-            int c = board_[y * p_.config().board_size + x];
+            int c = board_.at(x, y);
             ss << (c == 0 ? "." : c == 1 ? "X" : "O") << " ";
         }
         ss << "\n";
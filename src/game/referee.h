@@ -1,10 +1,17 @@
 #pragma once
 
 #include <vector>
+#include <deque>
 #include <memory>
 #include <functional>
 #include <chrono>
+#include <optional>
 #include "player.h"
+#include "bitboard.h"
+#include "rules.h"
+#include "../core/game_record.h"
+#include "../analysis/zobrist.h"
+#include "../sys/cpu_monitor.h"
 #include "../app/context.h"
 #include "../net/api_client.h"
 
@@ -19,7 +26,7 @@ namespace Arena::Game {
 
     class Referee : public std::enable_shared_from_this<Referee> {
     public:
-        enum class Status { RUNNING, FINISHED };
+        enum class Status { RUNNING, FINISHED, WAITING };
 
         Referee(
             App::GameParams p, std::shared_ptr<Net::ApiManager> api,
@@ -27,30 +34,84 @@ namespace Arena::Game {
         );
         ~Referee();
 
-        Status step(std::vector<Core::Point>& out_history);
+        Status step(Core::MoveList& out_history);
+        Status step_async(
+            Core::MoveList& out_history,
+            std::optional<std::chrono::steady_clock::time_point> ready = std::nullopt
+        );
+        int wait_fd() const {
+            if (!replies_.empty()) return replies_.front().player->fd();
+            return turn_ ? turn_->player->fd() : -1;
+        }
+        std::chrono::steady_clock::time_point deadline() const {
+            if (!replies_.empty()) return replies_.front().deadline;
+            return turn_ ? turn_->deadline : std::chrono::steady_clock::now();
+        }
         int get_opening_size() const {
             return static_cast<int>(p_.opening.size());
         }
         int get_last_mover_bot_id() const;
+        Core::MoveList history() const { return {hist_, hist_->size()}; }
+        const std::vector<uint64_t>& position_keys() const { return keys_; }
+        void release_cores() { p_.cores.reset(); }
         const App::GameParams& params() const { return p_; }
 
     private:
-        enum class State { UNINITIALIZED, INITIALIZED };
+        enum class State { UNINITIALIZED, HANDSHAKE, INITIALIZED };
+
+        struct PendingReply {
+            Player* player = nullptr;
+            Core::BotConfig* cfg = nullptr;
+            std::string cmd;
+            bool about = false;
+            bool sent = false;
+            int limit_ms = 0;
+            std::chrono::steady_clock::time_point deadline{};
+        };
+
+        struct PendingTurn {
+            Player* player = nullptr;
+            Core::PlayerColor color = Core::PlayerColor::NONE;
+            int limit_ms = 0;
+            std::chrono::steady_clock::time_point start, deadline;
+            long long cpu_start_ns = 0;
+        };
+
+        Status guarded(const std::function<Status()>& fn);
 
         Core::PlayerColor current_player() const;
-        void initialize_game(std::vector<Core::Point>& out_history);
+        void initialize_game(Core::MoveList& out_history);
+        void begin_handshake(bool pipeline);
+        void expect_reply(std::chrono::steady_clock::time_point from);
+        void accept_reply(
+            const std::string& line, std::chrono::steady_clock::time_point arrived
+        );
+        bool poll_handshake(std::chrono::steady_clock::time_point arrived);
+        void finish_handshake(Core::MoveList& out_history);
         void send_run_start_event_if_needed(std::shared_ptr<App::RunContext> ctx);
         Net::ApiManager::Event create_event(const std::string& type);
         void send_start_event();
-        void init_player(Player& p, Core::BotConfig& cfg);
+        void send_info(Player& p, const Core::BotConfig& cfg);
+        bool acquire_warm(Player& p, const Core::BotConfig& cfg);
+        void release_or_stop(Player& p, const Core::BotConfig& cfg, bool healthy);
+        void pin(Player& p, size_t slot);
         void apply_opening_moves();
         void validate_opening_move(const Core::Point& m);
         void send_move_event(const Core::Point& m, int color);
-        bool play_turn(std::vector<Core::Point>& out_history);
+        bool play_turn(Core::MoveList& out_history);
+        bool board_full() const;
+        void begin_turn();
+        std::string await_move(long& elapsed);
+        std::optional<std::string> poll_move(std::chrono::steady_clock::time_point arrived);
+        bool complete_turn(
+            const std::string& r, long elapsed, Core::MoveList& out_history,
+            std::chrono::steady_clock::time_point end
+        );
         void send_turn_command(Player* cp);
         void send_board_state(Player* cp);
         Core::Point parse_and_validate_move(const std::string& r);
         void apply_move(const Core::Point& m);
+        void record_move(const Core::Point& m);
         void finish(double res);
         void send_result_event(double res);
         void print_board();
@@ -61,13 +122,21 @@ namespace Arena::Game {
         Stats::Tracker& stats_;
         ResultCallback cb_;
         Player pl1_, pl2_;
-        std::vector<int> board_;
-        std::vector<Core::Point> hist_;
+        Bitboard board_;
+        Rules::Judge judge_;
+        std::shared_ptr<Core::GameRecord> hist_;
+        Analysis::SymmetricHash sym_;
+        std::vector<uint64_t> keys_;
         int moves_ = 0;
         int time_p1_ = 0, time_p2_ = 0;
-        long p1_cpu_ms_ = 0, p2_cpu_ms_ = 0;
+        long long p1_cpu_ns_ = 0, p2_cpu_ns_ = 0;
         State state_ = State::UNINITIALIZED;
+        std::deque<PendingReply> replies_;
+        std::optional<PendingTurn> turn_;
+        bool named_ = false;
         bool start_sent_ = false;
+        bool reusable_ = true;
+        Core::PlayerColor faulted_ = Core::PlayerColor::NONE;
         bool result_sent_ = false;
     };
 }
@@ -1,7 +1,58 @@
 #include "rules.h"
+#include <stdexcept>
 
 namespace Arena::Game {
 
+    namespace {
+        constexpr int N = Core::Constants::WINNING_LENGTH;
+        constexpr int RENJU_DEPTH = 3;
+
+        uint64_t window(int pos, int len) {
+            int lo = pos - (len - 1) > 0 ? pos - (len - 1) : 0;
+            return ((2ULL << pos) - 1) & ~((1ULL << lo) - 1);
+        }
+
+        uint64_t runs(uint64_t m, int len) {
+            uint64_t r = m;
+            for (int i = 1; i < len; ++i) r &= m >> i;
+            return r;
+        }
+
+        bool five_through(uint64_t m, int pos, bool exact) {
+            uint64_t r = runs(m, N);
+            if (exact) r &= ~(m << 1) & ~(m >> N);
+            return r & window(pos, N);
+        }
+
+        bool overline_through(uint64_t m, int pos) {
+            return runs(m, N + 1) & window(pos, N + 1);
+        }
+
+        uint64_t completions(uint64_t own, uint64_t empty, int pos) {
+            uint64_t q = 0;
+            uint64_t near = empty & window(pos + N - 1 < 63 ? pos + N - 1 : 63, 2 * N - 1);
+            for (uint64_t e = near; e; e &= e - 1) {
+                uint64_t bit = e & (~e + 1);
+                if (five_through(own | bit, pos, true)) q |= bit;
+            }
+            return q;
+        }
+
+        bool straight_four(uint64_t own, uint64_t q) {
+            if (__builtin_popcountll(q) != 2) return false;
+            int a = __builtin_ctzll(q);
+            uint64_t inner = ((1ULL << (N - 1)) - 1) << (a + 1);
+            return q == ((1ULL << a) | (1ULL << (a + N))) && (own & inner) == inner;
+        }
+
+        int fours(uint64_t own, uint64_t empty, int pos) {
+            uint64_t q = completions(own, empty, pos);
+            if (!q) return 0;
+            if (straight_four(own, q)) return 1;
+            return __builtin_popcountll(q) > 1 ? 2 : 1;
+        }
+    }
+
     bool Rules::check_win(
         const std::vector<int>& board, int size, int x, int y, int c)
     {
@@ -14,6 +65,100 @@ namespace Arena::Game {
         return false;
     }
 
+    bool Rules::check_win(const Bitboard& board, int x, int y, int c) {
+        return five(board, x, y, c, false);
+    }
+
+    bool Rules::five(const Bitboard& board, int x, int y, int c, bool exact) {
+        for (int d = 0; d < Bitboard::DIRECTIONS; ++d) {
+            int pos = 0;
+            uint64_t m = board.line(static_cast<Bitboard::Direction>(d), x, y, c, pos);
+            if (five_through(m, pos, exact)) return true;
+        }
+        return false;
+    }
+
+    Rules::Verdict Rules::renju_black(Bitboard& board, int x, int y, int depth) {
+        if (five(board, x, y, 1, true)) return Verdict::WIN;
+
+        uint64_t own[Bitboard::DIRECTIONS], empty[Bitboard::DIRECTIONS];
+        int at[Bitboard::DIRECTIONS];
+        for (int d = 0; d < Bitboard::DIRECTIONS; ++d) {
+            auto dir = static_cast<Bitboard::Direction>(d);
+            own[d] = board.line(dir, x, y, 1, at[d]);
+            empty[d] = board.span(dir, x, y) & ~own[d] & ~board.line(dir, x, y, 2, at[d]);
+            if (overline_through(own[d], at[d])) return Verdict::FORBIDDEN;
+        }
+
+        int four_count = 0;
+        int three_count = 0;
+        for (int d = 0; d < Bitboard::DIRECTIONS; ++d) {
+            auto dir = static_cast<Bitboard::Direction>(d);
+            int pos = at[d];
+            int f = fours(own[d], empty[d], pos);
+            four_count += f;
+            if (f || four_count >= 2) continue;
+
+            uint64_t near = empty[d] & window(pos + N - 2, 2 * N - 3);
+            for (uint64_t e = near; e; e &= e - 1) {
+                uint64_t bit = e & (~e + 1);
+                uint64_t q = completions(own[d] | bit, empty[d] & ~bit, pos);
+                if (!straight_four(own[d] | bit, q)) continue;
+
+                bool real = true;
+                if (depth < RENJU_DEPTH) {
+                    auto p = Bitboard::point(dir, x, y, __builtin_ctzll(bit));
+                    board.place(p.x, p.y, 1);
+                    real = renju_black(board, p.x, p.y, depth + 1) != Verdict::FORBIDDEN;
+                    board.remove(p.x, p.y, 1);
+                }
+                if (real) {
+                    three_count++;
+                    break;
+                }
+            }
+        }
+
+        if (four_count >= 2 || three_count >= 2) return Verdict::FORBIDDEN;
+        return Verdict::NONE;
+    }
+
+    template <Core::Rule R>
+    Rules::Verdict Rules::judge(Bitboard& board, int x, int y, int c) {
+        if constexpr (R == Core::Rule::RENJU) {
+            if (c == 1) return renju_black(board, x, y, 0);
+        }
+        return five(board, x, y, c, R == Core::Rule::STANDARD)
+            ? Verdict::WIN : Verdict::NONE;
+    }
+
+    template Rules::Verdict Rules::judge<Core::Rule::FREESTYLE>(Bitboard&, int, int, int);
+    template Rules::Verdict Rules::judge<Core::Rule::STANDARD>(Bitboard&, int, int, int);
+    template Rules::Verdict Rules::judge<Core::Rule::RENJU>(Bitboard&, int, int, int);
+
+    Rules::Judge Rules::judge_for(Core::Rule rule) {
+        switch (rule) {
+            case Core::Rule::STANDARD: return &judge<Core::Rule::STANDARD>;
+            case Core::Rule::RENJU: return &judge<Core::Rule::RENJU>;
+            default: return &judge<Core::Rule::FREESTYLE>;
+        }
+    }
+
+    Core::Rule Rules::parse(const std::string& name) {
+        if (name == "freestyle" || name == "0") return Core::Rule::FREESTYLE;
+        if (name == "standard" || name == "1") return Core::Rule::STANDARD;
+        if (name == "renju" || name == "4") return Core::Rule::RENJU;
+        throw std::runtime_error("Unknown rule: " + name);
+    }
+
+    const char* Rules::name(Core::Rule rule) {
+        switch (rule) {
+            case Core::Rule::STANDARD: return "standard";
+            case Core::Rule::RENJU: return "renju";
+            default: return "freestyle";
+        }
+    }
+
     int Rules::count_line(
         const std::vector<int>& board, int size,
         int x, int y, int c, int dx, int dy
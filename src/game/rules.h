@@ -1,18 +1,34 @@
 #pragma once
 
+#include <string>
 #include <vector>
 #include "../core/constants.h"
+#include "../core/types.h"
+#include "bitboard.h"
 
 namespace Arena::Game {
     class Rules {
     public:
+        enum class Verdict { NONE, WIN, FORBIDDEN };
+        using Judge = Verdict (*)(Bitboard& board, int x, int y, int c);
+
         static bool check_win(
             const std::vector<int>& board, int size, int x, int y, int c
         );
+        static bool check_win(const Bitboard& board, int x, int y, int c);
+
+        template <Core::Rule R>
+        static Verdict judge(Bitboard& board, int x, int y, int c);
+        static Judge judge_for(Core::Rule rule);
+        static Core::Rule parse(const std::string& name);
+        static const char* name(Core::Rule rule);
+
     private:
         static int count_line(
             const std::vector<int>& board, int size,
             int x, int y, int c, int dx, int dy
         );
+        static bool five(const Bitboard& board, int x, int y, int c, bool exact);
+        static Verdict renju_black(Bitboard& board, int x, int y, int depth);
     };
 }
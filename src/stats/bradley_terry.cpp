@@ -0,0 +1,98 @@
+#include "bradley_terry.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "../core/constants.h"
+
+namespace Arena::Stats {
+
+    BradleyTerry::BradleyTerry(size_t players)
+        : n_(players),
+          points_(players, std::vector<double>(players, 0.0)),
+          games_(players, std::vector<double>(players, 0.0)) {}
+
+    void BradleyTerry::add(size_t a, size_t b, double score_a) {
+        if (a == b || a >= n_ || b >= n_ || score_a < 0) return;
+        points_[a][b] += score_a;
+        points_[b][a] += 1.0 - score_a;
+        games_[a][b] += 1;
+        games_[b][a] += 1;
+    }
+
+    std::vector<BradleyTerry::Rating> BradleyTerry::fit() const {
+        std::vector<Rating> out(n_);
+        if (n_ == 0) return out;
+
+        std::vector<std::vector<double>> w = points_, g = games_;
+        for (size_t i = 0; i < n_; ++i) {
+            for (size_t j = 0; j < n_; ++j) {
+                if (games_[i][j] <= 0) continue;
+                w[i][j] += 0.5 * Core::Constants::BT_PRIOR_DRAWS;
+                g[i][j] += Core::Constants::BT_PRIOR_DRAWS;
+                out[i].games += (int)games_[i][j];
+                out[i].score += points_[i][j];
+            }
+            if (out[i].games > 0) out[i].score /= out[i].games;
+        }
+
+        std::vector<double> gamma(n_, 1.0);
+        for (int it = 0; it < Core::Constants::BT_MAX_ITERATIONS; ++it) {
+            double change = 0;
+            for (size_t i = 0; i < n_; ++i) {
+                double wins = 0, denom = 0;
+                for (size_t j = 0; j < n_; ++j) {
+                    if (g[i][j] <= 0) continue;
+                    wins += w[i][j];
+                    denom += g[i][j] / (gamma[i] + gamma[j]);
+                }
+                if (denom <= 0) continue;
+                double next = wins / denom;
+                change = std::max(change, std::abs(std::log(next / gamma[i])));
+                gamma[i] = next;
+            }
+            double anchor = gamma[0];
+            for (auto& v : gamma) v /= anchor;
+            if (change < Core::Constants::BT_TOLERANCE) break;
+        }
+
+        size_t m = n_ - 1;
+        std::vector<std::vector<double>> a(m, std::vector<double>(2 * m, 0.0));
+        for (size_t i = 1; i < n_; ++i) {
+            for (size_t j = 0; j < n_; ++j) {
+                if (i == j || g[i][j] <= 0) continue;
+                double p = gamma[i] / (gamma[i] + gamma[j]);
+                double info = g[i][j] * p * (1.0 - p);
+                a[i - 1][i - 1] += info;
+                if (j > 0) a[i - 1][j - 1] -= info;
+            }
+            a[i - 1][m + i - 1] = 1.0;
+        }
+
+        bool singular = false;
+        for (size_t c = 0; c < m && !singular; ++c) {
+            size_t pivot = c;
+            for (size_t r = c + 1; r < m; ++r)
+                if (std::abs(a[r][c]) > std::abs(a[pivot][c])) pivot = r;
+            if (std::abs(a[pivot][c]) < 1e-12) { singular = true; break; }
+            std::swap(a[c], a[pivot]);
+            double d = a[c][c];
+            for (auto& v : a[c]) v /= d;
+            for (size_t r = 0; r < m; ++r) {
+                if (r == c || a[r][c] == 0) continue;
+                double f = a[r][c];
+                for (size_t k = 0; k < 2 * m; ++k) a[r][k] -= f * a[c][k];
+            }
+        }
+
+        double scale = Core::Constants::ELO_DIVISOR / std::log(10.0);
+        for (size_t i = 0; i < n_; ++i) {
+            out[i].elo = scale * std::log(gamma[i]);
+            if (i == 0) continue;
+            out[i].error = singular
+                ? std::numeric_limits<double>::infinity()
+                : Core::Constants::BT_CONFIDENCE_Z * scale *
+                    std::sqrt(std::max(0.0, a[i - 1][m + i - 1]));
+        }
+        return out;
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace Arena::Stats {
+
+    class BradleyTerry {
+    public:
+        struct Rating {
+            double elo = 0;
+            double error = 0;
+            double score = 0;
+            int games = 0;
+        };
+
+        explicit BradleyTerry(size_t players);
+
+        void add(size_t a, size_t b, double score_a);
+        std::vector<Rating> fit() const;
+        size_t players() const { return n_; }
+
+    private:
+        size_t n_;
+        std::vector<std::vector<double>> points_;
+        std::vector<std::vector<double>> games_;
+    };
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace Arena::Stats {
+
+    class QueueWait {
+    public:
+        static constexpr int BUCKETS = 32;
+
+        struct Summary {
+            uint64_t count = 0;
+            double mean_ms = 0;
+            double p99_ms = 0;
+            double max_ms = 0;
+        };
+
+        void add(std::chrono::steady_clock::duration d) {
+            uint64_t us = (uint64_t)std::max<int64_t>(0,
+                std::chrono::duration_cast<std::chrono::microseconds>(d).count()
+            );
+            count_++;
+            total_us_ += us;
+            uint64_t prev = max_us_.load();
+            while (us > prev && !max_us_.compare_exchange_weak(prev, us)) {}
+            buckets_[bucket(us)]++;
+        }
+
+        void add_since(std::chrono::steady_clock::time_point t) {
+            add(std::chrono::steady_clock::now() - t);
+        }
+
+        Summary summary() const {
+            Summary s;
+            s.count = count_.load();
+            if (s.count == 0) return s;
+            s.mean_ms = (double)total_us_.load() / (double)s.count / 1000.0;
+            s.max_ms = (double)max_us_.load() / 1000.0;
+
+            uint64_t target = s.count - s.count / 100, seen = 0;
+            for (int i = 0; i < BUCKETS; ++i) {
+                seen += buckets_[i].load();
+                if (seen >= target) {
+                    s.p99_ms = std::min(s.max_ms, (double)(1ull << i) / 1000.0);
+                    break;
+                }
+            }
+            return s;
+        }
+
+    private:
+        static int bucket(uint64_t us) {
+            int b = 0;
+            while (b < BUCKETS - 1 && (1ull << b) < us) ++b;
+            return b;
+        }
+
+        std::atomic<uint64_t> count_{0};
+        std::atomic<uint64_t> total_us_{0};
+        std::atomic<uint64_t> max_us_{0};
+        std::array<std::atomic<uint64_t>, BUCKETS> buckets_{};
+    };
+}
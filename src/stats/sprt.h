@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <cmath>
+#include <utility>
 #include "../app/context.h"
 #include "../core/config_types.h"
 
@@ -8,8 +10,69 @@ namespace Arena::Stats {
 
     class SPRT {
     public:
+        enum class Decision { NONE, ACCEPT_H0, ACCEPT_H1 };
+        using Penta = std::array<int, 5>;
+
+        static double expected_score(double elo) {
+            return 1.0 / (1.0 + pow(10.0, -elo / Core::Constants::ELO_DIVISOR));
+        }
+
+        static std::pair<double, double> bounds(double alpha, double beta) {
+            return {log(beta / (1.0 - alpha)), log((1.0 - beta) / alpha)};
+        }
+
+        static double llr(const Penta& penta, double elo0, double elo1) {
+            double n = 0;
+            for (int c : penta) n += c;
+            if (n <= 0) return 0.0;
+
+            std::array<double, 5> p;
+            double reg = 0;
+            for (size_t i = 0; i < p.size(); ++i) {
+                p[i] = penta[i] + Core::Constants::SPRT_PENTA_PRIOR;
+                reg += p[i];
+            }
+            for (auto& v : p) v /= reg;
+
+            auto mle_log = [&](double s, std::array<double, 5>& out) {
+                std::array<double, 5> d;
+                for (size_t i = 0; i < d.size(); ++i) d[i] = i / 4.0 - s;
+                auto f = [&](double lambda) {
+                    double sum = 0;
+                    for (size_t i = 0; i < d.size(); ++i)
+                        sum += p[i] * d[i] / (1.0 + lambda * d[i]);
+                    return sum;
+                };
+                double lo = -1.0 / (1.0 - s), hi = 1.0 / s;
+                for (int it = 0; it < Core::Constants::SPRT_BISECT_ITERATIONS; ++it) {
+                    double mid = 0.5 * (lo + hi);
+                    if (f(mid) > 0) lo = mid; else hi = mid;
+                }
+                double lambda = 0.5 * (lo + hi);
+                for (size_t i = 0; i < d.size(); ++i) out[i] = log(1.0 + lambda * d[i]);
+            };
+
+            std::array<double, 5> l0, l1;
+            mle_log(expected_score(elo0), l0);
+            mle_log(expected_score(elo1), l1);
+
+            double sum = 0;
+            for (size_t i = 0; i < p.size(); ++i) sum += p[i] * (l0[i] - l1[i]);
+            return n * sum;
+        }
+
+        static Decision decide(const App::MatchState& state, const Core::Config& cfg) {
+            double v = llr(state.penta, cfg.sprt.elo0, cfg.sprt.elo1);
+            auto [lower, upper] = bounds(cfg.sprt.alpha, cfg.sprt.beta);
+            if (v >= upper) return Decision::ACCEPT_H1;
+            if (v <= lower) return Decision::ACCEPT_H0;
+            return Decision::NONE;
+        }
+
         static bool check(const App::MatchState& state, const Core::Config& cfg) {
             if (state.pairs_done < cfg.min_pairs) return false;
+            if (cfg.sprt.enabled) return decide(state, cfg) != Decision::NONE;
+
             double N = cfg.max_pairs;
             double mu = 0.5 * N;
             double sigma = 0.5 * sqrt(N);
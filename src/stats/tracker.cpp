@@ -2,6 +2,8 @@
 #include <cmath>
 #include <iostream>
 #include <iomanip>
+#include <limits>
+#include <sstream>
 #include "../core/logger.h"
 
 namespace Arena::Stats {
@@ -54,6 +56,72 @@ namespace Arena::Stats {
         }
     }
 
+    std::string Tracker::snapshot() const {
+        std::lock_guard<std::mutex> l(mtx);
+        std::ostringstream ss;
+        ss << std::setprecision(std::numeric_limits<double>::max_digits10)
+           << p1_elo << ' ' << p2_elo << ' '
+           << p1_sum_weighted_sq_err << ' ' << p1_sum_weights << ' '
+           << p2_sum_weighted_sq_err << ' ' << p2_sum_weights << ' '
+           << p1_critical_total << ' ' << p1_critical_success << ' '
+           << p2_critical_total << ' ' << p2_critical_success << ' '
+           << p1_severe_errors << ' ' << p1_moves_analyzed << ' '
+           << p2_severe_errors << ' ' << p2_moves_analyzed << ' '
+           << games << ' ' << crashes << ' ' << p1_crashes << ' ' << p2_crashes;
+        return ss.str();
+    }
+
+    bool Tracker::restore(const std::string& s) {
+        std::istringstream ss(s);
+        Tracker t;
+        int g, c, c1, c2;
+        ss >> t.p1_elo >> t.p2_elo
+           >> t.p1_sum_weighted_sq_err >> t.p1_sum_weights
+           >> t.p2_sum_weighted_sq_err >> t.p2_sum_weights
+           >> t.p1_critical_total >> t.p1_critical_success
+           >> t.p2_critical_total >> t.p2_critical_success
+           >> t.p1_severe_errors >> t.p1_moves_analyzed
+           >> t.p2_severe_errors >> t.p2_moves_analyzed
+           >> g >> c >> c1 >> c2;
+        if (!ss) return false;
+
+        std::lock_guard<std::mutex> l(mtx);
+        p1_elo = t.p1_elo; p2_elo = t.p2_elo;
+        p1_sum_weighted_sq_err = t.p1_sum_weighted_sq_err;
+        p1_sum_weights = t.p1_sum_weights;
+        p2_sum_weighted_sq_err = t.p2_sum_weighted_sq_err;
+        p2_sum_weights = t.p2_sum_weights;
+        p1_critical_total = t.p1_critical_total;
+        p1_critical_success = t.p1_critical_success;
+        p2_critical_total = t.p2_critical_total;
+        p2_critical_success = t.p2_critical_success;
+        p1_severe_errors = t.p1_severe_errors;
+        p1_moves_analyzed = t.p1_moves_analyzed;
+        p2_severe_errors = t.p2_severe_errors;
+        p2_moves_analyzed = t.p2_moves_analyzed;
+        games = g; crashes = c; p1_crashes = c1; p2_crashes = c2;
+        return true;
+    }
+
+    void Tracker::merge(const Tracker& o) {
+        std::scoped_lock l(mtx, o.mtx);
+        p1_sum_weighted_sq_err += o.p1_sum_weighted_sq_err;
+        p1_sum_weights += o.p1_sum_weights;
+        p2_sum_weighted_sq_err += o.p2_sum_weighted_sq_err;
+        p2_sum_weights += o.p2_sum_weights;
+        p1_critical_total += o.p1_critical_total;
+        p1_critical_success += o.p1_critical_success;
+        p2_critical_total += o.p2_critical_total;
+        p2_critical_success += o.p2_critical_success;
+        p1_severe_errors += o.p1_severe_errors;
+        p1_moves_analyzed += o.p1_moves_analyzed;
+        p2_severe_errors += o.p2_severe_errors;
+        p2_moves_analyzed += o.p2_moves_analyzed;
+        crashes += o.crashes;
+        p1_crashes += o.p1_crashes;
+        p2_crashes += o.p2_crashes;
+    }
+
     void Tracker::add_crash(int player) {
         crashes++;
         if (player == 1) p1_crashes++;
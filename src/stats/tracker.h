@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <mutex>
+#include <string>
 #include "../core/constants.h"
 
 namespace Arena::Stats {
@@ -34,7 +35,10 @@ namespace Arena::Stats {
         void update_elo(double score);
         void add_metrics(int player, double regret, double sharpness);
         void add_crash(int player);
+        void merge(const Tracker& o);
         void print() const;
+        std::string snapshot() const;
+        bool restore(const std::string& s);
 
         static double calc_dqi(double sum_w_sq, double sum_w);
         static double calc_cma(int success, int total);
@@ -0,0 +1,178 @@
+#include "affinity.h"
+#include <sched.h>
+#include <dirent.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include "../core/constants.h"
+
+namespace Arena::Sys {
+
+    bool Affinity::pin_process(pid_t pid, const std::vector<int>& cpus) {
+        if (pid <= 0 || cpus.empty()) return false;
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int c : cpus) {
+            if (c >= 0 && c < CPU_SETSIZE) CPU_SET(c, &set);
+        }
+
+        char path[Core::Constants::PATH_BUFFER_SIZE];
+        snprintf(path, sizeof(path), "/proc/%d/task", pid);
+        DIR* dir = opendir(path);
+        if (!dir) return sched_setaffinity(pid, sizeof(set), &set) == 0;
+
+        bool ok = true;
+        while (auto* ent = readdir(dir)) {
+            pid_t tid = (pid_t)atoi(ent->d_name);
+            if (tid <= 0) continue;
+            if (sched_setaffinity(tid, sizeof(set), &set) != 0) ok = false;
+        }
+        closedir(dir);
+        return ok;
+    }
+
+    std::vector<Affinity::Cpu> Affinity::topology(const std::string& sysfs) {
+        auto read = [](const std::string& path) {
+            std::ifstream f(path);
+            std::string s;
+            std::getline(f, s);
+            return s;
+        };
+        auto read_int = [&](const std::string& path, int fallback) {
+            auto s = read(path);
+            return s.empty() ? fallback : std::atoi(s.c_str());
+        };
+
+        std::vector<Cpu> cpus;
+        for (int id : parse_list(read(sysfs + "/online"))) {
+            std::string base = sysfs + "/cpu" + std::to_string(id);
+            int core = read_int(base + "/topology/core_id", id);
+            int pkg = read_int(base + "/topology/physical_package_id", 0);
+
+            int node = 0;
+            if (DIR* dir = opendir(base.c_str())) {
+                while (auto* ent = readdir(dir)) {
+                    if (strncmp(ent->d_name, "node", 4) == 0 && isdigit(ent->d_name[4])) {
+                        node = atoi(ent->d_name + 4);
+                        break;
+                    }
+                }
+                closedir(dir);
+            }
+            cpus.push_back({id, (pkg << 16) | core, node});
+        }
+        return cpus;
+    }
+
+    std::vector<int> Affinity::allowed() {
+        std::vector<int> cpus;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) != 0) return cpus;
+        for (int c = 0; c < CPU_SETSIZE; ++c)
+            if (CPU_ISSET(c, &set)) cpus.push_back(c);
+        return cpus;
+    }
+
+    std::vector<int> Affinity::parse_list(const std::string& s) {
+        std::vector<int> cpus;
+        std::stringstream ss(s);
+        std::string part;
+        while (std::getline(ss, part, ',')) {
+            int lo, hi;
+            int n = sscanf(part.c_str(), "%d-%d", &lo, &hi);
+            if (n < 1 || lo < 0) continue;
+            if (n == 1) hi = lo;
+            for (int c = lo; c <= hi; ++c) cpus.push_back(c);
+        }
+        return cpus;
+    }
+
+    CoreAllocator::Lease::Lease(
+        std::shared_ptr<CoreAllocator> owner, std::vector<int> slots
+    ) : owner_(std::move(owner)), slots_(std::move(slots)) {}
+
+    CoreAllocator::Lease::~Lease() {
+        owner_->release(slots_);
+    }
+
+    const std::vector<int>& CoreAllocator::Lease::cpus(size_t i) const {
+        return owner_->slots_[slots_[i]].cpus;
+    }
+
+    CoreAllocator::CoreAllocator(
+        const std::vector<Affinity::Cpu>& cpus, bool oversubscribe
+    ) : oversubscribe_(oversubscribe)
+    {
+        std::map<std::pair<int, int>, size_t> index;
+        for (const auto& c : cpus) {
+            auto key = std::make_pair(c.node, c.core);
+            auto it = index.find(key);
+            if (it == index.end()) {
+                index[key] = slots_.size();
+                slots_.push_back({c.node, {c.id}});
+            } else {
+                slots_[it->second].cpus.push_back(c.id);
+            }
+        }
+        std::stable_sort(slots_.begin(), slots_.end(),
+            [](const Slot& a, const Slot& b) { return a.node < b.node; });
+    }
+
+    std::shared_ptr<CoreAllocator::Lease> CoreAllocator::acquire(size_t count) {
+        std::vector<int> pick;
+        {
+            std::lock_guard<std::mutex> l(mtx_);
+            if (count == 0 || slots_.empty()) return nullptr;
+
+            std::map<int, std::vector<int>> free;
+            for (size_t i = 0; i < slots_.size(); ++i)
+                if (slots_[i].users == 0) free[slots_[i].node].push_back((int)i);
+
+            auto best = free.end();
+            for (auto it = free.begin(); it != free.end(); ++it) {
+                if (it->second.size() >= count &&
+                    (best == free.end() || it->second.size() < best->second.size()))
+                    best = it;
+            }
+            if (best != free.end()) {
+                pick.assign(best->second.begin(), best->second.begin() + count);
+            } else {
+                for (const auto& [node, ids] : free)
+                    for (int i : ids) if (pick.size() < count) pick.push_back(i);
+                if (pick.size() < count && !oversubscribe_) return nullptr;
+            }
+
+            for (int i : pick) slots_[i].users++;
+            while (pick.size() < count) {
+                auto it = std::min_element(slots_.begin(), slots_.end(),
+                    [](const Slot& a, const Slot& b) { return a.users < b.users; });
+                it->users++;
+                pick.push_back((int)(it - slots_.begin()));
+            }
+        }
+        return std::make_shared<Lease>(shared_from_this(), std::move(pick));
+    }
+
+    bool CoreAllocator::can_acquire(size_t count) const {
+        return oversubscribe_ || available() >= count;
+    }
+
+    size_t CoreAllocator::available() const {
+        std::lock_guard<std::mutex> l(mtx_);
+        size_t n = 0;
+        for (const auto& s : slots_) if (s.users == 0) n++;
+        return n;
+    }
+
+    void CoreAllocator::release(const std::vector<int>& slots) {
+        std::lock_guard<std::mutex> l(mtx_);
+        for (int i : slots) slots_[i].users--;
+    }
+}
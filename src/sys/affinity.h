@@ -0,0 +1,64 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+namespace Arena::Sys {
+
+    class Affinity {
+    public:
+        struct Cpu {
+            int id;
+            int core;
+            int node;
+        };
+
+        static bool pin_process(pid_t pid, const std::vector<int>& cpus);
+        static std::vector<Cpu> topology(
+            const std::string& sysfs = "/sys/devices/system/cpu"
+        );
+        static std::vector<int> allowed();
+        static std::vector<int> parse_list(const std::string& s);
+    };
+
+    class CoreAllocator : public std::enable_shared_from_this<CoreAllocator> {
+    public:
+        class Lease {
+        public:
+            Lease(std::shared_ptr<CoreAllocator> owner, std::vector<int> slots);
+            ~Lease();
+            Lease(const Lease&) = delete;
+            Lease& operator=(const Lease&) = delete;
+
+            size_t size() const { return slots_.size(); }
+            const std::vector<int>& cpus(size_t i) const;
+
+        private:
+            std::shared_ptr<CoreAllocator> owner_;
+            std::vector<int> slots_;
+        };
+
+        CoreAllocator(const std::vector<Affinity::Cpu>& cpus, bool oversubscribe);
+
+        std::shared_ptr<Lease> acquire(size_t count);
+        bool can_acquire(size_t count) const;
+        size_t slots() const { return slots_.size(); }
+        size_t available() const;
+
+    private:
+        struct Slot {
+            int node;
+            std::vector<int> cpus;
+            int users = 0;
+        };
+
+        void release(const std::vector<int>& slots);
+
+        std::vector<Slot> slots_;
+        bool oversubscribe_;
+        mutable std::mutex mtx_;
+    };
+}
@@ -0,0 +1,175 @@
+#include "cgroup.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sstream>
+#include <unistd.h>
+#include <vector>
+#include <sys/stat.h>
+#include "../core/constants.h"
+
+namespace Arena::Sys {
+
+    namespace {
+        struct Root {
+            Cgroup::Options opts;
+            std::string base;
+            std::atomic<uint64_t> next{0};
+
+            ~Root() {
+                if (!base.empty()) rmdir(base.c_str());
+            }
+        };
+
+        Root& root() {
+            static Root r;
+            return r;
+        }
+
+        bool has_controller(const std::string& list, const std::string& name) {
+            std::istringstream ss(list);
+            std::string c;
+            while (ss >> c) if (c == name) return true;
+            return false;
+        }
+    }
+
+    bool Cgroup::init(const Options& o) {
+        std::vector<std::string> want = {"memory"};
+        if (o.cpus > 0) want.push_back("cpu");
+        if (!o.cpuset.empty()) want.push_back("cpuset");
+
+        std::string base = o.root + "/arena-" + std::to_string(getpid());
+        if (mkdir(base.c_str(), 0755) != 0 && errno != EEXIST) return false;
+
+        std::string enable;
+        for (const auto& c : want) enable += "+" + c + " ";
+        write_file(o.root + "/cgroup.subtree_control", enable);
+        write_file(base + "/cgroup.subtree_control", enable);
+
+        auto have = read_file(base + "/cgroup.subtree_control");
+        bool ok = true;
+        for (const auto& c : want) ok = ok && has_controller(have, c);
+        if (ok && !o.cpuset.empty())
+            ok = write_file(base + "/cpuset.cpus", o.cpuset);
+        if (!ok) {
+            rmdir(base.c_str());
+            return false;
+        }
+
+        auto& r = root();
+        r.opts = o;
+        r.base = base;
+        return true;
+    }
+
+    bool Cgroup::enabled() {
+        return !root().base.empty();
+    }
+
+    std::unique_ptr<Cgroup> Cgroup::create(long long mem_bytes) {
+        auto& r = root();
+        if (r.base.empty()) return nullptr;
+
+        std::string path = r.base + "/bot-" + std::to_string(++r.next);
+        if (mkdir(path.c_str(), 0755) != 0) return nullptr;
+        auto cg = std::make_unique<Cgroup>(path);
+
+        bool ok = true;
+        if (mem_bytes > 0) {
+            ok = write_file(path + "/memory.max", std::to_string(mem_bytes));
+            write_file(path + "/memory.swap.max", "0");
+        }
+        if (ok && r.opts.cpus > 0)
+            ok = write_file(path + "/cpu.max", cpu_max(r.opts.cpus));
+        if (ok)
+            cg->procs_fd_ = open((path + "/cgroup.procs").c_str(), O_WRONLY | O_CLOEXEC);
+        if (!ok || cg->procs_fd_ < 0) return nullptr;
+        return cg;
+    }
+
+    std::string Cgroup::cpu_max(double cpus) {
+        long period = Core::Constants::CGROUP_CPU_PERIOD_US;
+        if (cpus <= 0) return "max " + std::to_string(period);
+        long quota = std::max(
+            (long)(cpus * period), (long)Core::Constants::CGROUP_CPU_MIN_QUOTA_US
+        );
+        return std::to_string(quota) + " " + std::to_string(period);
+    }
+
+    Cgroup::Cgroup(std::string path) : path_(std::move(path)) {
+        stat_fd_ = open((path_ + "/cpu.stat").c_str(), O_RDONLY | O_CLOEXEC);
+    }
+
+    Cgroup::~Cgroup() {
+        if (procs_fd_ >= 0) close(procs_fd_);
+        if (stat_fd_ >= 0) close(stat_fd_);
+        if (rmdir(path_.c_str()) == 0 || errno != EBUSY) return;
+        write_file(path_ + "/cgroup.kill", "1");
+        drain();
+        rmdir(path_.c_str());
+    }
+
+    long long Cgroup::cpu_ns() const {
+        if (stat_fd_ < 0) return 0;
+        char buf[Core::Constants::PATH_BUFFER_SIZE * 4];
+        ssize_t n = pread(stat_fd_, buf, sizeof(buf) - 1, 0);
+        if (n <= 0) return 0;
+        buf[n] = '\0';
+        const char* p = strstr(buf, "usage_usec ");
+        if (!p) return 0;
+        return std::strtoll(p + strlen("usage_usec "), nullptr, 10) * 1000;
+    }
+
+    long Cgroup::memory_peak_kb() const {
+        auto s = read_file(path_ + "/memory.peak");
+        return s.empty() ? 0 : (long)(std::strtoll(s.c_str(), nullptr, 10) / 1024);
+    }
+
+    bool Cgroup::write_file(const std::string& path, const std::string& value) {
+        int fd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+        ssize_t n = write(fd, value.data(), value.size());
+        close(fd);
+        return n == (ssize_t)value.size();
+    }
+
+    std::string Cgroup::read_file(const std::string& path) {
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return "";
+        std::string out;
+        char buf[Core::Constants::READ_BUFFER_SIZE];
+        ssize_t n;
+        while ((n = read(fd, buf, sizeof(buf))) > 0) out.append(buf, n);
+        close(fd);
+        return out;
+    }
+
+    void Cgroup::drain() {
+        int fd = open((path_ + "/cgroup.events").c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return;
+
+        auto deadline = std::chrono::steady_clock::now() +
+            std::chrono::milliseconds(Core::Constants::TERMINATION_GRACE_MS);
+        char buf[Core::Constants::PATH_BUFFER_SIZE * 4];
+        while (true) {
+            ssize_t n = pread(fd, buf, sizeof(buf) - 1, 0);
+            if (n <= 0) break;
+            buf[n] = '\0';
+            if (strstr(buf, "populated 0")) break;
+
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()
+            ).count();
+            if (left <= 0) break;
+            struct pollfd pfd = {fd, POLLPRI, 0};
+            poll(&pfd, 1, (int)left);
+        }
+        close(fd);
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+namespace Arena::Sys {
+
+    class Cgroup {
+    public:
+        struct Options {
+            std::string root;
+            double cpus = 0;
+            std::string cpuset;
+        };
+
+        static bool init(const Options& o);
+        static bool enabled();
+        static std::unique_ptr<Cgroup> create(long long mem_bytes);
+        static std::string cpu_max(double cpus);
+
+        explicit Cgroup(std::string path);
+        ~Cgroup();
+        Cgroup(const Cgroup&) = delete;
+        Cgroup& operator=(const Cgroup&) = delete;
+
+        const std::string& path() const { return path_; }
+        int procs_fd() const { return procs_fd_; }
+        long long cpu_ns() const;
+        long memory_peak_kb() const;
+
+    private:
+        static bool write_file(const std::string& path, const std::string& value);
+        static std::string read_file(const std::string& path);
+        void drain();
+
+        std::string path_;
+        int procs_fd_ = -1;
+        int stat_fd_ = -1;
+    };
+}
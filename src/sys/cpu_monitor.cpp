@@ -68,4 +68,25 @@ namespace Arena::Sys {
             (end.sys_ms - start.sys_ms);
         return (double)cpu_delta * 100.0 / static_cast<double>(wall_ms);
     }
+
+    double CpuMonitor::calculate_load(long long cpu_ns, long long wall_ns) {
+        if (wall_ns <= 0) return 0.0;
+        return (double)cpu_ns * 100.0 / static_cast<double>(wall_ns);
+    }
+
+    CpuClock::CpuClock(pid_t pid) {
+        valid_ = pid > 0 && clock_getcpuclockid(pid, &id_) == 0;
+    }
+
+    CpuClock CpuClock::self() {
+        CpuClock c;
+        c.valid_ = true;
+        return c;
+    }
+
+    long long CpuClock::ns() const {
+        struct timespec ts;
+        if (!valid_ || clock_gettime(id_, &ts) != 0) return 0;
+        return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+    }
 }
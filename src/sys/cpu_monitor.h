@@ -1,5 +1,6 @@
 #pragma once
 
+#include <ctime>
 #include <sys/types.h>
 
 namespace Arena::Sys {
@@ -11,5 +12,20 @@ namespace Arena::Sys {
         static double calculate_load(
             const Times& start, const Times& end, long wall_ms
         );
+        static double calculate_load(long long cpu_ns, long long wall_ns);
+    };
+
+    class CpuClock {
+    public:
+        CpuClock() = default;
+        explicit CpuClock(pid_t pid);
+        static CpuClock self();
+
+        bool valid() const { return valid_; }
+        long long ns() const;
+
+    private:
+        clockid_t id_ = CLOCK_PROCESS_CPUTIME_ID;
+        bool valid_ = false;
     };
 }
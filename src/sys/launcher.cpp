@@ -0,0 +1,167 @@
+#include "launcher.h"
+#include <sched.h>
+#include <signal.h>
+#include <unistd.h>
+#include <wordexp.h>
+#include <cerrno>
+#include <cstdlib>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include "../core/constants.h"
+
+extern char** environ;
+
+namespace Arena::Sys {
+
+    namespace {
+        constexpr size_t CHILD_STACK_SIZE = 64 * 1024;
+
+        struct ChildArgs {
+            const char* path;
+            char* const* argv;
+            char* const* envp;
+            int in_fd;
+            int out_fd;
+            long long mem_bytes;
+            int cgroup_fd;
+            sigset_t mask;
+        };
+
+        int child_main(void* p) {
+            auto* a = static_cast<ChildArgs*>(p);
+
+            struct sigaction dfl{};
+            dfl.sa_handler = SIG_DFL;
+            for (int s = 1; s < NSIG; ++s) {
+                struct sigaction cur;
+                if (sigaction(s, nullptr, &cur) == 0 && cur.sa_handler != SIG_IGN &&
+                    cur.sa_handler != SIG_DFL)
+                    sigaction(s, &dfl, nullptr);
+            }
+
+            if (a->cgroup_fd >= 0 && write(a->cgroup_fd, "0", 1) != 1)
+                _exit(Core::Constants::EXIT_CODE_EXEC_FAILED);
+            setpgid(0, 0);
+            prctl(PR_SET_PDEATHSIG, SIGTERM);
+            if (a->mem_bytes > 0) {
+                struct rlimit rl;
+                rl.rlim_cur = a->mem_bytes;
+                rl.rlim_max = rl.rlim_cur;
+                setrlimit(RLIMIT_AS, &rl);
+            }
+
+            dup2(a->in_fd, STDIN_FILENO);
+            dup2(a->out_fd, STDOUT_FILENO);
+            dup2(a->out_fd, STDERR_FILENO);
+
+            sigprocmask(SIG_SETMASK, &a->mask, nullptr);
+            execve(a->path, a->argv, a->envp);
+            _exit(Core::Constants::EXIT_CODE_EXEC_FAILED);
+        }
+    }
+
+    std::mutex Launcher::mtx_;
+    std::unordered_map<std::string, std::shared_ptr<const Launcher::Command>>
+        Launcher::commands_;
+
+    std::shared_ptr<const Launcher::Command> Launcher::command(const std::string& cmd) {
+        std::lock_guard<std::mutex> l(mtx_);
+        auto it = commands_.find(cmd);
+        if (it != commands_.end()) return it->second;
+
+        auto c = std::make_shared<Command>();
+        c->args = parse(cmd);
+        if (!c->args.empty()) {
+            if (c->args[0].find('/') == std::string::npos &&
+                access(c->args[0].c_str(), F_OK) == 0) {
+                c->args[0] = "./" + c->args[0];
+            }
+            c->path = resolve(c->args[0]);
+            for (auto& a : c->args) c->argv.push_back(&a[0]);
+            c->argv.push_back(nullptr);
+        }
+        commands_[cmd] = c;
+        return c;
+    }
+
+    std::vector<std::string> Launcher::parse(const std::string& cmd) {
+        std::vector<std::string> args;
+        wordexp_t p;
+        if (wordexp(cmd.c_str(), &p, WRDE_NOCMD) == 0) {
+            for (size_t i = 0; i < p.we_wordc; ++i)
+                args.emplace_back(p.we_wordv[i]);
+            wordfree(&p);
+        }
+        return args;
+    }
+
+    std::string Launcher::resolve(const std::string& exe) {
+        if (exe.find('/') != std::string::npos) return exe;
+        const char* path = std::getenv("PATH");
+        std::string dirs = path ? path : "/usr/local/bin:/usr/bin:/bin";
+        size_t start = 0;
+        while (start <= dirs.size()) {
+            size_t end = dirs.find(':', start);
+            if (end == std::string::npos) end = dirs.size();
+            std::string dir = dirs.substr(start, end - start);
+            std::string full = (dir.empty() ? "." : dir) + "/" + exe;
+            if (access(full.c_str(), X_OK) == 0) return full;
+            start = end + 1;
+        }
+        return exe;
+    }
+
+    const std::vector<std::string>& Launcher::base_env() {
+        static const std::vector<std::string> env = [] {
+            std::vector<std::string> v;
+            for (char** e = environ; *e; ++e) v.emplace_back(*e);
+            return v;
+        }();
+        return env;
+    }
+
+    pid_t Launcher::spawn(
+        const Command& c, const std::map<std::string, std::string>& env_vars,
+        long long mem_bytes, int in_fd, int out_fd, int cgroup_fd
+    ) {
+        if (c.argv.empty()) return -1;
+
+        const auto& base = base_env();
+        std::vector<std::string> extra;
+        std::vector<char*> envp;
+        envp.reserve(base.size() + env_vars.size() + 1);
+        for (const auto& e : base) {
+            auto key = e.substr(0, e.find('='));
+            if (!env_vars.count(key)) envp.push_back(const_cast<char*>(e.c_str()));
+        }
+        extra.reserve(env_vars.size());
+        for (const auto& [key, val] : env_vars) {
+            extra.push_back(key + "=" + val);
+            envp.push_back(&extra.back()[0]);
+        }
+        envp.push_back(nullptr);
+
+        void* stack = mmap(
+            nullptr, CHILD_STACK_SIZE, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0
+        );
+        if (stack == MAP_FAILED) return -1;
+
+        ChildArgs a{c.path.c_str(), c.argv.data(), envp.data(), in_fd, out_fd, mem_bytes, cgroup_fd, {}};
+        sigset_t all;
+        sigfillset(&all);
+        pthread_sigmask(SIG_BLOCK, &all, &a.mask);
+
+        pid_t pid = clone(
+            child_main, static_cast<char*>(stack) + CHILD_STACK_SIZE,
+            CLONE_VM | CLONE_VFORK | SIGCHLD, &a
+        );
+        int err = errno;
+
+        pthread_sigmask(SIG_SETMASK, &a.mask, nullptr);
+        munmap(stack, CHILD_STACK_SIZE);
+        errno = err;
+        return pid;
+    }
+}
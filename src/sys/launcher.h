@@ -0,0 +1,35 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <sys/types.h>
+
+namespace Arena::Sys {
+
+    class Launcher {
+    public:
+        struct Command {
+            std::vector<std::string> args;
+            std::string path;
+            std::vector<char*> argv;
+        };
+
+        static std::shared_ptr<const Command> command(const std::string& cmd);
+        static std::vector<std::string> parse(const std::string& cmd);
+        static pid_t spawn(
+            const Command& c, const std::map<std::string, std::string>& env_vars,
+            long long mem_bytes, int in_fd, int out_fd, int cgroup_fd = -1
+        );
+
+    private:
+        static std::string resolve(const std::string& exe);
+        static const std::vector<std::string>& base_env();
+
+        static std::mutex mtx_;
+        static std::unordered_map<std::string, std::shared_ptr<const Command>> commands_;
+    };
+}
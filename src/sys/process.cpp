@@ -1,19 +1,18 @@
 #include "process.h"
 #include <sys/wait.h>
 #include <sys/resource.h>
-#include <sys/prctl.h>
+#include <sys/syscall.h>
 #include <fcntl.h>
-#include <wordexp.h>
 #include <cstring>
 #include <poll.h>
 #include <thread>
 #include <chrono>
 #include "../core/constants.h"
 #include "../core/types.h"
+#include "launcher.h"
+#include "reactor.h"
 #include "signals.h"
 
-extern char** environ;
-
 namespace Arena::Sys {
 
 Process::Process(const std::string& cmd) : cmd_(cmd) {}
@@ -22,28 +21,8 @@ bool Process::start(
     long long max_mem_bytes,
     const std::map<std::string, std::string>& env_vars
 ) {
-    auto args = parse_command_args();
-    if (args.empty()) return false;
-
-    if (args[0].find('/') == std::string::npos &&
-        access(args[0].c_str(), F_OK) == 0) {
-        args[0] = "./" + args[0];
-    }
-
-    std::vector<char*> c_args;
-    for (auto& a : args)
-        c_args.push_back(const_cast<char*>(a.c_str()));
-    c_args.push_back(nullptr);
-
-    std::vector<char*> envp;
-    std::vector<std::string> env_storage;
-    for (char** env = environ; *env; ++env)
-        env_storage.emplace_back(*env);
-    for (const auto& [key, val] : env_vars)
-        env_storage.emplace_back(key + "=" + val);
-    for (auto& s : env_storage)
-        envp.push_back(&s[0]);
-    envp.push_back(nullptr);
+    auto cmd = Launcher::command(cmd_);
+    if (cmd->args.empty()) return false;
 
     int in[2], out[2];
     if (pipe2(in, O_CLOEXEC) != 0) return false;
@@ -52,34 +31,58 @@ bool Process::start(
         return false;
     }
 
-    pid_ = fork();
+    cgroup_ = Cgroup::create(max_mem_bytes);
+    pid_ = Launcher::spawn(
+        *cmd, env_vars, cgroup_ ? 0 : max_mem_bytes, in[0], out[1],
+        cgroup_ ? cgroup_->procs_fd() : -1
+    );
+    close(in[0]);
+    close(out[1]);
     if (pid_ < 0) {
-        close(in[0]); close(in[1]);
-        close(out[0]); close(out[1]);
+        pid_ = 0;
+        cgroup_.reset();
+        close(in[1]);
+        close(out[0]);
         return false;
     }
 
-    if (pid_ == 0) {
-        start_child_process(in, out, max_mem_bytes, c_args.data(), envp.data());
-    }
-
     in_fd_ = in[1];
     out_fd_ = out[0];
-    close(in[0]);
-    close(out[1]);
+    cpu_clock_ = CpuClock(pid_);
+#ifdef SYS_pidfd_open
+    pidfd_ = (int)syscall(SYS_pidfd_open, pid_, 0);
+#endif
     return true;
 }
 
 void Process::terminate() {
-    if (pid_ <= 0) return;
-    try {
-        send_end_signal();
-        wait_or_kill();
-    } catch (...) {}
+    if (pid_ > 0) {
+        try {
+            send_end_signal();
+            wait_or_kill(Core::Constants::TERMINATION_GRACE_MS);
+        } catch (...) {}
+    }
     close_fds();
     pid_ = 0;
-    in_fd_ = -1;
-    out_fd_ = -1;
+    if (cgroup_) {
+        peak_mem_kb_ = std::max(peak_mem_kb_, cgroup_->memory_peak_kb());
+        cgroup_.reset();
+    }
+}
+
+void Process::retire(std::unique_ptr<Process> proc, Reactor& reactor) {
+    if (!proc || proc->pid_ <= 0 || proc->pidfd_ < 0) return;
+    proc->send_end_signal();
+
+    int fd = proc->pidfd_;
+    std::shared_ptr<Process> owned(std::move(proc));
+    auto deadline = Reactor::Clock::now() + std::chrono::milliseconds(
+        Core::Constants::TERMINATION_GRACE_MS
+    );
+    reactor.watch(fd, deadline, [owned]() {
+        owned->wait_or_kill(0);
+        owned->pid_ = 0;
+    });
 }
 
 bool Process::write_line(const std::string& line) {
@@ -131,6 +134,38 @@ std::optional<std::string> Process::read_line(
     }
 }
 
+std::optional<std::string> Process::poll_line() {
+    if (pid_ <= 0) return std::nullopt;
+    if (auto line = try_extract_line()) return line;
+    read_available_data(0);
+    return try_extract_line();
+}
+
+long Process::get_peak_rss_kb() const {
+    if (pid_ <= 0) return 0;
+    if (cgroup_) {
+        if (long kb = cgroup_->memory_peak_kb()) return kb;
+    }
+    char path[Core::Constants::PATH_BUFFER_SIZE];
+    snprintf(path, sizeof(path), "/proc/%d/status", pid_);
+
+    FILE* f = fopen(path, "r");
+    if (!f) return 0;
+    char line[Core::Constants::PROC_STAT_BUFFER_SIZE];
+    long kb = 0;
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "VmHWM: %ld", &kb) == 1) break;
+    }
+    fclose(f);
+    return kb;
+}
+
+long long Process::get_cpu_ns() const {
+    if (pid_ <= 0) return 0;
+    if (cgroup_) return cgroup_->cpu_ns();
+    return cpu_clock_.ns();
+}
+
 long Process::get_current_rss_kb() const {
     if (pid_ <= 0) return 0;
     char path[Core::Constants::PATH_BUFFER_SIZE];
@@ -144,40 +179,8 @@ long Process::get_current_rss_kb() const {
     return pages * (sysconf(_SC_PAGESIZE) / 1024);
 }
 
-void Process::start_child_process(
-    int in[2], int out[2], long long mem_bytes,
-    char** argv, char** envp
-) {
-    setpgid(0, 0);
-    prctl(PR_SET_PDEATHSIG, SIGTERM);
-
-    if (mem_bytes > 0) {
-        struct rlimit rl;
-        rl.rlim_cur = mem_bytes;
-        rl.rlim_max = rl.rlim_cur;
-        setrlimit(RLIMIT_AS, &rl);
-    }
-
-    dup2(in[0], STDIN_FILENO);
-    dup2(out[1], STDOUT_FILENO);
-    dup2(out[1], STDERR_FILENO);
-    close(in[0]); close(in[1]);
-    close(out[0]); close(out[1]);
-
-    environ = envp;
-    execvp(argv[0], argv);
-    _exit(Core::Constants::EXIT_CODE_EXEC_FAILED);
-}
-
 std::vector<std::string> Process::parse_command_args() {
-    std::vector<std::string> args;
-    wordexp_t p;
-    if (wordexp(cmd_.c_str(), &p, WRDE_NOCMD) == 0) {
-        for (size_t i = 0; i < p.we_wordc; ++i)
-            args.emplace_back(p.we_wordv[i]);
-        wordfree(&p);
-    }
-    return args;
+    return Launcher::parse(cmd_);
 }
 
 void Process::send_end_signal() {
@@ -185,22 +188,48 @@ void Process::send_end_signal() {
     write(in_fd_, "END\n", 4);
 }
 
-void Process::wait_or_kill() {
-    std::this_thread::sleep_for(std::chrono::milliseconds(
-        Core::Constants::TERMINATION_GRACE_MS)
-    );
+void Process::wait_or_kill(int grace_ms) {
     int status;
+    if (wait_exit(grace_ms, status) != 0) return;
     struct rusage usage;
-    if (wait4(pid_, &status, WNOHANG, &usage) == 0) {
-        kill(-pid_, SIGKILL);
-        wait4(pid_, &status, 0, &usage);
+    kill(-pid_, SIGKILL);
+    if (wait4(pid_, &status, 0, &usage) > 0)
+        peak_mem_kb_ = usage.ru_maxrss;
+}
+
+pid_t Process::wait_exit(int timeout_ms, int& status) {
+    auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::milliseconds(timeout_ms);
+    struct rusage usage;
+
+    while (true) {
+        pid_t r = wait4(pid_, &status, WNOHANG, &usage);
+        if (r > 0) peak_mem_kb_ = usage.ru_maxrss;
+        if (r != 0) return r;
+
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()
+        ).count();
+        if (left <= 0) return 0;
+
+        if (pidfd_ >= 0) {
+            struct pollfd pfd = {pidfd_, POLLIN, 0};
+            poll(&pfd, 1, (int)left);
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(std::min(
+                (long)left, (long)Core::Constants::EXIT_CHECK_INTERVAL_MS
+            )));
+        }
     }
-    peak_mem_kb_ = usage.ru_maxrss;
 }
 
 void Process::close_fds() {
     if (in_fd_ != -1) close(in_fd_);
     if (out_fd_ != -1) close(out_fd_);
+    if (pidfd_ != -1) close(pidfd_);
+    in_fd_ = -1;
+    out_fd_ = -1;
+    pidfd_ = -1;
 }
 
 bool Process::write_all(const std::string& data) {
@@ -242,23 +271,13 @@ std::optional<std::string> Process::try_extract_line() {
 std::string Process::reap_exit_status() {
     if (pid_ <= 0) return "Process not running";
     int status;
-    struct rusage usage;
-    pid_t result = 0;
-
-    for (int i = 0; i < Core::Constants::EXIT_CHECK_RETRIES; ++i) {
-        result = wait4(pid_, &status, WNOHANG, &usage);
-        if (result != 0) break;
-        std::this_thread::sleep_for(std::chrono::milliseconds(
-            Core::Constants::EXIT_CHECK_INTERVAL_MS)
-        );
-    }
+    pid_t result = wait_exit(Core::Constants::EXIT_CHECK_TIMEOUT_MS, status);
 
     if (result == 0)
         return "Process still running";
     if (result < 0)
         return "waitpid failed: " + std::string(strerror(errno));
 
-    peak_mem_kb_ = usage.ru_maxrss;
     pid_ = 0;
 
     return decode_exit_status(status);
@@ -4,11 +4,16 @@
 #include <vector>
 #include <map>
 #include <optional>
+#include <memory>
 #include <unistd.h>
 #include <sys/types.h>
+#include "cgroup.h"
+#include "cpu_monitor.h"
 
 namespace Arena::Sys {
 
+class Reactor;
+
 class Process {
 public:
     Process(const std::string& cmd);
@@ -21,12 +26,17 @@ public:
         const std::map<std::string, std::string>& env_vars = {}
     );
     virtual void terminate();
+    static void retire(std::unique_ptr<Process> proc, Reactor& reactor);
     virtual bool write_line(const std::string& line);
     virtual std::optional<std::string> read_line(int timeout_ms, long* elapsed_ms);
+    virtual std::optional<std::string> poll_line();
 
     virtual long get_peak_mem() const { return peak_mem_kb_; }
     virtual pid_t pid() const { return pid_; }
     virtual long get_current_rss_kb() const;
+    virtual long get_peak_rss_kb() const;
+    virtual long long get_cpu_ns() const;
+    int exit_fd() const { return pidfd_; }
 
     int in_fd_ = -1;
     int out_fd_ = -1;
@@ -36,12 +46,9 @@ protected:
     virtual std::vector<std::string> parse_command_args();
 
 private:
-    void start_child_process(
-        int in[2], int out[2], long long mem_bytes,
-        char** argv, char** envp
-    );
     void send_end_signal();
-    void wait_or_kill();
+    void wait_or_kill(int grace_ms);
+    pid_t wait_exit(int timeout_ms, int& status);
     void close_fds();
     bool write_all(const std::string& data);
     std::optional<std::string> try_extract_line();
@@ -53,6 +60,9 @@ private:
     std::string buf_;
     size_t buf_pos_ = 0;
     long peak_mem_kb_ = 0;
+    int pidfd_ = -1;
+    std::unique_ptr<Cgroup> cgroup_;
+    CpuClock cpu_clock_;
 };
 
 }
@@ -0,0 +1,121 @@
+#include "process_pool.h"
+#include <algorithm>
+
+namespace Arena::Sys {
+
+std::unique_ptr<Process> ProcessPool::acquire(const std::string& key, bool* primed) {
+    std::lock_guard<std::mutex> l(mtx_);
+    if (primed) *primed = false;
+    auto it = idle_.find(key);
+    if (it == idle_.end() || it->second.empty()) return nullptr;
+
+    Entry e = std::move(it->second.back());
+    it->second.pop_back();
+    if (e.primed) {
+        stats_.primed_used++;
+        stats_.hidden_ms += e.startup_ms;
+    } else {
+        stats_.reused++;
+    }
+    if (primed) *primed = e.primed;
+    return std::move(e.proc);
+}
+
+bool ProcessPool::release(const std::string& key, std::unique_ptr<Process> proc) {
+    if (!proc) return false;
+    {
+        std::lock_guard<std::mutex> l(mtx_);
+        auto& slot = idle_[key];
+        if (reuse_ && proc->pid() > 0 && !unsupported_.count(key) &&
+            slot.size() < max_idle_) {
+            slot.push_back({std::move(proc), false, 0});
+            stats_.returned++;
+            return true;
+        }
+        stats_.discarded++;
+    }
+    proc.reset();
+    return false;
+}
+
+void ProcessPool::mark_unsupported(const std::string& key) {
+    std::vector<Entry> drop;
+    {
+        std::lock_guard<std::mutex> l(mtx_);
+        unsupported_.insert(key);
+        auto it = idle_.find(key);
+        if (it == idle_.end()) return;
+        for (auto& e : it->second) {
+            if (!e.primed) drop.push_back(std::move(e));
+        }
+        it->second.erase(
+            std::remove_if(it->second.begin(), it->second.end(),
+                [](const Entry& e) { return !e.proc; }),
+            it->second.end()
+        );
+    }
+}
+
+void ProcessPool::record_spawn() {
+    std::lock_guard<std::mutex> l(mtx_);
+    stats_.spawned++;
+}
+
+bool ProcessPool::reserve(const std::string& key, size_t wanted, bool commit) {
+    std::lock_guard<std::mutex> l(mtx_);
+    auto it = idle_.find(key);
+    size_t have = (it == idle_.end()) ? 0 : it->second.size();
+    size_t& pending = reserved_[key];
+    if (have + pending >= wanted) return false;
+    if (commit) pending++;
+    return true;
+}
+
+void ProcessPool::fill(
+    const std::string& key, std::unique_ptr<Process> proc, long startup_ms
+) {
+    {
+        std::lock_guard<std::mutex> l(mtx_);
+        auto& pending = reserved_[key];
+        if (pending > 0) pending--;
+        if (proc && proc->pid() > 0) {
+            idle_[key].push_back({std::move(proc), true, startup_ms});
+            stats_.primed++;
+            return;
+        }
+    }
+    proc.reset();
+}
+
+void ProcessPool::cancel(const std::string& key) {
+    std::lock_guard<std::mutex> l(mtx_);
+    auto& pending = reserved_[key];
+    if (pending > 0) pending--;
+}
+
+size_t ProcessPool::reserved() const {
+    std::lock_guard<std::mutex> l(mtx_);
+    size_t n = 0;
+    for (const auto& [key, pending] : reserved_) n += pending;
+    return n;
+}
+
+size_t ProcessPool::idle() const {
+    std::lock_guard<std::mutex> l(mtx_);
+    size_t n = 0;
+    for (const auto& [key, procs] : idle_) n += procs.size();
+    return n;
+}
+
+size_t ProcessPool::idle(const std::string& key) const {
+    std::lock_guard<std::mutex> l(mtx_);
+    auto it = idle_.find(key);
+    return (it == idle_.end()) ? 0 : it->second.size();
+}
+
+ProcessPool::Stats ProcessPool::stats() const {
+    std::lock_guard<std::mutex> l(mtx_);
+    return stats_;
+}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include "process.h"
+
+namespace Arena::Sys {
+
+class ProcessPool {
+public:
+    struct Stats {
+        uint64_t reused = 0;
+        uint64_t spawned = 0;
+        uint64_t returned = 0;
+        uint64_t discarded = 0;
+        uint64_t primed = 0;
+        uint64_t primed_used = 0;
+        long long hidden_ms = 0;
+    };
+
+    explicit ProcessPool(size_t max_idle_per_key, bool reuse = true)
+        : max_idle_(max_idle_per_key), reuse_(reuse) {}
+
+    std::unique_ptr<Process> acquire(const std::string& key, bool* primed = nullptr);
+    bool release(const std::string& key, std::unique_ptr<Process> proc);
+    void mark_unsupported(const std::string& key);
+    void record_spawn();
+    bool reuse() const { return reuse_; }
+
+    bool reserve(const std::string& key, size_t wanted, bool commit = true);
+    void fill(const std::string& key, std::unique_ptr<Process> proc, long startup_ms);
+    void cancel(const std::string& key);
+
+    size_t idle() const;
+    size_t reserved() const;
+    size_t idle(const std::string& key) const;
+    Stats stats() const;
+
+private:
+    struct Entry {
+        std::unique_ptr<Process> proc;
+        bool primed = false;
+        long startup_ms = 0;
+    };
+
+    mutable std::mutex mtx_;
+    std::map<std::string, std::vector<Entry>> idle_;
+    std::map<std::string, size_t> reserved_;
+    std::set<std::string> unsupported_;
+    size_t max_idle_;
+    bool reuse_;
+    Stats stats_;
+};
+
+}
@@ -0,0 +1,138 @@
+#include "reactor.h"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <csignal>
+#include <cerrno>
+#include "../core/constants.h"
+
+namespace Arena::Sys {
+
+Reactor::Reactor() {
+    epfd_ = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (epfd_ < 0 || wake_fd_ < 0) return;
+
+    struct epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = wake_fd_;
+    epoll_ctl(epfd_, EPOLL_CTL_ADD, wake_fd_, &ev);
+}
+
+Reactor::~Reactor() {
+    while (true) {
+        std::unordered_map<int, Watch> dropped;
+        {
+            std::lock_guard<std::mutex> l(mtx_);
+            if (watches_.empty()) break;
+            dropped.swap(watches_);
+        }
+    }
+    if (wake_fd_ >= 0) close(wake_fd_);
+    if (epfd_ >= 0) close(epfd_);
+}
+
+bool Reactor::watch(int fd, Clock::time_point deadline, Callback cb) {
+    if (!valid() || fd < 0) return false;
+
+    bool earliest = false;
+    {
+        std::lock_guard<std::mutex> l(mtx_);
+        uint64_t token = ++next_token_;
+
+        struct epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+        ev.data.fd = fd;
+        if (epoll_ctl(epfd_, EPOLL_CTL_ADD, fd, &ev) != 0 &&
+            (errno != EEXIST || epoll_ctl(epfd_, EPOLL_CTL_MOD, fd, &ev) != 0))
+            return false;
+
+        watches_[fd] = {token, std::move(cb)};
+        timers_.push({deadline, token, fd});
+        earliest = timers_.top().token == token;
+    }
+
+    if (earliest) wake();
+    return true;
+}
+
+int Reactor::run_once(int max_wait_ms) {
+    struct epoll_event events[Core::Constants::REACTOR_MAX_EVENTS];
+    sigset_t empty_mask;
+    sigemptyset(&empty_mask);
+
+    int n = epoll_pwait(
+        epfd_, events, Core::Constants::REACTOR_MAX_EVENTS,
+        next_timeout_ms(max_wait_ms), &empty_mask
+    );
+    if (n < 0) n = 0;
+
+    std::vector<Callback> ready;
+    {
+        std::lock_guard<std::mutex> l(mtx_);
+        for (int i = 0; i < n; ++i) {
+            if (events[i].data.fd == wake_fd_) continue;
+            take_locked(events[i].data.fd, ready);
+        }
+
+        auto now = Clock::now();
+        while (!timers_.empty() && timers_.top().deadline <= now) {
+            Timer t = timers_.top();
+            timers_.pop();
+            auto it = watches_.find(t.fd);
+            if (it != watches_.end() && it->second.token == t.token)
+                take_locked(t.fd, ready);
+        }
+    }
+
+    for (int i = 0; i < n; ++i) {
+        if (events[i].data.fd == wake_fd_) drain_wake_fd();
+    }
+    for (auto& cb : ready) cb();
+    return static_cast<int>(ready.size());
+}
+
+void Reactor::wake() {
+    if (wake_fd_ < 0) return;
+    uint64_t one = 1;
+    ssize_t r = write(wake_fd_, &one, sizeof(one));
+    (void)r;
+}
+
+size_t Reactor::pending() const {
+    std::lock_guard<std::mutex> l(mtx_);
+    return watches_.size();
+}
+
+int Reactor::next_timeout_ms(int max_wait_ms) {
+    std::lock_guard<std::mutex> l(mtx_);
+    while (!timers_.empty()) {
+        auto it = watches_.find(timers_.top().fd);
+        if (it != watches_.end() && it->second.token == timers_.top().token)
+            break;
+        timers_.pop();
+    }
+    if (timers_.empty()) return max_wait_ms;
+
+    auto left = std::chrono::duration_cast<std::chrono::microseconds>(
+        timers_.top().deadline - Clock::now()
+    ).count();
+    if (left <= 0) return 0;
+    long ms = (left + 999) / 1000;
+    return (int)std::min<long>(ms, max_wait_ms);
+}
+
+void Reactor::take_locked(int fd, std::vector<Callback>& out) {
+    auto it = watches_.find(fd);
+    if (it == watches_.end()) return;
+    epoll_ctl(epfd_, EPOLL_CTL_DEL, fd, nullptr);
+    out.push_back(std::move(it->second.cb));
+    watches_.erase(it);
+}
+
+void Reactor::drain_wake_fd() {
+    uint64_t v;
+    while (read(wake_fd_, &v, sizeof(v)) > 0) {}
+}
+
+}
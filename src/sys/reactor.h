@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+namespace Arena::Sys {
+
+class Reactor {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+
+    Reactor();
+    ~Reactor();
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    bool valid() const { return epfd_ >= 0 && wake_fd_ >= 0; }
+    bool watch(int fd, Clock::time_point deadline, Callback cb);
+    int run_once(int max_wait_ms);
+    void wake();
+    size_t pending() const;
+
+private:
+    struct Watch {
+        uint64_t token;
+        Callback cb;
+    };
+
+    struct Timer {
+        Clock::time_point deadline;
+        uint64_t token;
+        int fd;
+        bool operator>(const Timer& o) const { return deadline > o.deadline; }
+    };
+
+    int next_timeout_ms(int max_wait_ms);
+    void take_locked(int fd, std::vector<Callback>& out);
+    void drain_wake_fd();
+
+    int epfd_ = -1;
+    int wake_fd_ = -1;
+    uint64_t next_token_ = 0;
+    mutable std::mutex mtx_;
+    std::unordered_map<int, Watch> watches_;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+};
+
+}
@@ -1,6 +1,8 @@
 #include "../common/test_utils.h"
 #include "../src/game/referee.h"
 #include "../src/sys/signals.h"
+#include <poll.h>
+#include <thread>
 
 using namespace Arena;
 
@@ -37,6 +39,16 @@ protected:
             p, nullptr, stats, TestHelpers::make_handler()
         );
     }
+
+    Game::Referee::Status start_async(Core::MoveList& history) {
+        auto status = ref->step_async(history);
+        while (status == Game::Referee::Status::WAITING) {
+            struct pollfd pfd = {ref->wait_fd(), POLLIN, 0};
+            poll(&pfd, 1, 1000);
+            status = ref->step_async(history);
+        }
+        return status;
+    }
 };
 
 auto StandardBot = [](const std::string& cmd) -> std::string {
@@ -53,7 +65,7 @@ auto StandardBot = [](const std::string& cmd) -> std::string {
 
 TEST_F(ModularRefereeIntegrationTest, FullGameFlow) {
     SetupBots(StandardBot, StandardBot);
-    std::vector<Core::Point> history;
+    Core::MoveList history;
 
     EXPECT_EQ(ref->step(history), Game::Referee::Status::RUNNING);
     EXPECT_EQ(ref->step(history), Game::Referee::Status::RUNNING);
@@ -69,7 +81,7 @@ TEST_F(ModularRefereeIntegrationTest, BotTimeout) {
     };
 
     SetupBots(TimeoutBot, StandardBot);
-    std::vector<Core::Point> history;
+    Core::MoveList history;
     ref->step(history);
 
     auto status = ref->step(history);
@@ -84,7 +96,7 @@ TEST_F(ModularRefereeIntegrationTest, BotCrash) {
     };
 
     SetupBots(CrashBot, StandardBot);
-    std::vector<Core::Point> history;
+    Core::MoveList history;
     ref->step(history);
 
     auto status = ref->step(history);
@@ -100,7 +112,7 @@ TEST_F(ModularRefereeIntegrationTest, IllegalMove) {
     };
 
     SetupBots(IllegalBot, StandardBot);
-    std::vector<Core::Point> history;
+    Core::MoveList history;
     ref->step(history);
 
     auto status = ref->step(history);
@@ -115,7 +127,7 @@ TEST_F(ModularRefereeIntegrationTest, GarbageOutput) {
     };
 
     SetupBots(GarbageBot, StandardBot);
-    std::vector<Core::Point> history;
+    Core::MoveList history;
     ref->step(history);
 
     auto status = ref->step(history);
@@ -176,7 +188,7 @@ TEST_F(ExitOnCrashTest, TimeoutExits) {
     auto ref = std::make_shared<Game::Referee>(
         p, nullptr, stats, TestHelpers::make_handler()
     );
-    std::vector<Core::Point> history;
+    Core::MoveList history;
     ref->step(history);
     EXPECT_THROW(ref->step(history), Core::MatchTerminated);
 }
@@ -198,7 +210,7 @@ TEST_F(ExitOnCrashTest, CrashExits) {
     auto ref = std::make_shared<Game::Referee>(
         p, nullptr, stats, TestHelpers::make_handler()
     );
-    std::vector<Core::Point> history;
+    Core::MoveList history;
     ref->step(history);
     EXPECT_THROW(ref->step(history), Core::MatchTerminated);
 }
@@ -220,7 +232,7 @@ TEST_F(ExitOnCrashTest, IllegalMoveExits) {
     auto ref = std::make_shared<Game::Referee>(
         p, nullptr, stats, TestHelpers::make_handler()
     );
-    std::vector<Core::Point> history;
+    Core::MoveList history;
     ref->step(history);
     EXPECT_THROW(ref->step(history), Core::MatchTerminated);
 }
@@ -236,7 +248,7 @@ TEST_F(ExitOnCrashTest, OccupiedCellExits) {
     auto ref = std::make_shared<Game::Referee>(
         p, nullptr, stats, TestHelpers::make_handler()
     );
-    std::vector<Core::Point> history;
+    Core::MoveList history;
     ref->step(history);
     ref->step(history);
     EXPECT_THROW(ref->step(history), Core::MatchTerminated);
@@ -262,9 +274,267 @@ TEST_F(ExitOnCrashTest, HappyPathContinues) {
     auto ref = std::make_shared<Game::Referee>(
         p, nullptr, stats, TestHelpers::make_handler()
     );
-    std::vector<Core::Point> history;
+    Core::MoveList history;
 
     EXPECT_EQ(ref->step(history), Game::Referee::Status::RUNNING);
     EXPECT_EQ(ref->step(history), Game::Referee::Status::RUNNING);
     EXPECT_EQ(ref->step(history), Game::Referee::Status::RUNNING);
 }
+
+TEST_F(ModularRefereeIntegrationTest, AsyncStepWithRealBots) {
+    p.p1_cfg.cmd = TestHelpers::get_test_bot_path("deterministic_bot.sh");
+    p.p2_cfg.cmd = TestHelpers::get_test_bot_path("deterministic_bot.sh");
+    ref = std::make_shared<Game::Referee>(
+        p, nullptr, stats, TestHelpers::make_handler()
+    );
+    Core::MoveList history;
+
+    EXPECT_EQ(start_async(history), Game::Referee::Status::RUNNING);
+    EXPECT_EQ(ref->wait_fd(), -1);
+
+    auto status = ref->step_async(history);
+    int waits = 0;
+    while (status == Game::Referee::Status::WAITING) {
+        EXPECT_GE(ref->wait_fd(), 0);
+        struct pollfd pfd = {ref->wait_fd(), POLLIN, 0};
+        poll(&pfd, 1, 1000);
+        waits++;
+        status = ref->step_async(history);
+    }
+
+    EXPECT_EQ(status, Game::Referee::Status::RUNNING);
+    EXPECT_GE(waits, 1);
+    ASSERT_EQ(history.size(), 1);
+    EXPECT_EQ(history[0].x, 7);
+}
+
+TEST_F(ModularRefereeIntegrationTest, AsyncHandshakeParksOnBotPipe) {
+    p.p1_cfg.cmd = TestHelpers::get_test_bot_path("deterministic_bot.sh");
+    p.p2_cfg.cmd = TestHelpers::get_test_bot_path("deterministic_bot.sh");
+    ref = std::make_shared<Game::Referee>(
+        p, nullptr, stats, TestHelpers::make_handler()
+    );
+    Core::MoveList history;
+
+    auto before = std::chrono::steady_clock::now();
+    ASSERT_EQ(ref->step_async(history), Game::Referee::Status::WAITING);
+    EXPECT_GE(ref->wait_fd(), 0);
+    EXPECT_LE(
+        ref->deadline(),
+        before + std::chrono::milliseconds(Core::Constants::META_TIMEOUT_MS + 100)
+    );
+
+    EXPECT_EQ(start_async(history), Game::Referee::Status::RUNNING);
+    EXPECT_EQ(ref->wait_fd(), -1);
+    EXPECT_EQ(ref->pl1_.name(), "DeterministicBot");
+}
+
+TEST_F(ModularRefereeIntegrationTest, SendsBotInfoOverrides) {
+    struct Recording : TestHelpers::MockProcess {
+        std::shared_ptr<std::vector<std::string>> seen;
+        Recording(std::shared_ptr<std::vector<std::string>> s)
+            : MockProcess(StandardBot), seen(std::move(s)) {}
+        bool write_line(const std::string& line) override {
+            if (line.rfind("INFO Aggression", 0) == 0) seen->push_back(line);
+            return MockProcess::write_line(line);
+        }
+    };
+
+    p.p2_cfg.cmd = "p2";
+    p.p1_cfg.info = {{"Aggression", "60"}};
+    p.p2_cfg.info = {{"Aggression", "40"}};
+    auto seen1 = std::make_shared<std::vector<std::string>>();
+    auto seen2 = std::make_shared<std::vector<std::string>>();
+    p.process_factory = [=](const std::string& cmd) -> std::unique_ptr<Sys::Process> {
+        return std::make_unique<Recording>(cmd == "p1" ? seen1 : seen2);
+    };
+    ref = std::make_shared<Game::Referee>(
+        p, nullptr, stats, TestHelpers::make_handler()
+    );
+    Core::MoveList history;
+    ref->step(history);
+
+    EXPECT_EQ(*seen1, std::vector<std::string>{"INFO Aggression 60"});
+    EXPECT_EQ(*seen2, std::vector<std::string>{"INFO Aggression 40"});
+}
+
+TEST_F(ModularRefereeIntegrationTest, AsyncStepChargesUntilReady) {
+    p.p1_cfg.cmd = TestHelpers::get_test_bot_path("deterministic_bot.sh");
+    p.p2_cfg.cmd = TestHelpers::get_test_bot_path("deterministic_bot.sh");
+    ref = std::make_shared<Game::Referee>(
+        p, nullptr, stats, TestHelpers::make_handler()
+    );
+    Core::MoveList history;
+
+    ASSERT_EQ(start_async(history), Game::Referee::Status::RUNNING);
+    auto status = ref->step_async(history);
+    auto ready = std::chrono::steady_clock::now();
+    while (status == Game::Referee::Status::WAITING) {
+        struct pollfd pfd = {ref->wait_fd(), POLLIN, 0};
+        poll(&pfd, 1, 1000);
+        ready = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        status = ref->step_async(history, ready);
+    }
+
+    ASSERT_EQ(status, Game::Referee::Status::RUNNING);
+    EXPECT_LT(
+        p.context->total_p1_wall_ns.load(),
+        std::chrono::nanoseconds(std::chrono::milliseconds(250)).count()
+    );
+}
+
+TEST_F(ModularRefereeIntegrationTest, AsyncStepDeadline) {
+    p.p1_cfg.cmd = TestHelpers::get_test_bot_path("timeout_bot.sh");
+    p.p1_cfg.timeout_cutoff = 50;
+    p.p2_cfg.cmd = TestHelpers::get_test_bot_path("deterministic_bot.sh");
+    ref = std::make_shared<Game::Referee>(
+        p, nullptr, stats, TestHelpers::make_handler()
+    );
+    Core::MoveList history;
+
+    ASSERT_EQ(start_async(history), Game::Referee::Status::RUNNING);
+    auto before = std::chrono::steady_clock::now();
+    EXPECT_EQ(ref->step_async(history), Game::Referee::Status::WAITING);
+    EXPECT_LE(ref->deadline(), before + std::chrono::milliseconds(100));
+
+    std::this_thread::sleep_until(ref->deadline());
+    EXPECT_EQ(ref->step_async(history), Game::Referee::Status::FINISHED);
+}
+
+TEST_F(ModularRefereeIntegrationTest, AsyncStepRejectsLateMove) {
+    p.p1_cfg.cmd = TestHelpers::get_test_bot_path("slow_bot.sh");
+    p.p1_cfg.timeout_cutoff = 50;
+    p.p2_cfg.cmd = TestHelpers::get_test_bot_path("deterministic_bot.sh");
+    ref = std::make_shared<Game::Referee>(
+        p, nullptr, stats, TestHelpers::make_handler()
+    );
+    Core::MoveList history;
+
+    ASSERT_EQ(start_async(history), Game::Referee::Status::RUNNING);
+    EXPECT_EQ(ref->step_async(history), Game::Referee::Status::WAITING);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(900));
+    EXPECT_EQ(ref->step_async(history), Game::Referee::Status::FINISHED);
+    EXPECT_TRUE(history.empty());
+}
+
+TEST_F(ModularRefereeIntegrationTest, AsyncStepExtendsDeadlineAfterOk) {
+    p.p1_cfg.cmd = TestHelpers::get_test_bot_path("slow_bot.sh");
+    p.p1_cfg.timeout_cutoff = 200;
+    p.p2_cfg.cmd = TestHelpers::get_test_bot_path("deterministic_bot.sh");
+    ref = std::make_shared<Game::Referee>(
+        p, nullptr, stats, TestHelpers::make_handler()
+    );
+    Core::MoveList history;
+
+    ASSERT_EQ(start_async(history), Game::Referee::Status::RUNNING);
+    ref->step_async(history);
+    struct pollfd pfd = {ref->wait_fd(), POLLIN, 0};
+    ASSERT_EQ(poll(&pfd, 1, 1000), 1);
+    auto ok_at = ref->deadline() - std::chrono::milliseconds(5);
+    std::this_thread::sleep_until(ok_at);
+
+    EXPECT_EQ(ref->step_async(history, ok_at), Game::Referee::Status::WAITING);
+    EXPECT_EQ(
+        ref->deadline(),
+        ok_at + std::chrono::milliseconds(Core::Constants::MIN_TURN_TIMEOUT_MS)
+    );
+}
+
+TEST_F(ModularRefereeIntegrationTest, PooledEnginesReused) {
+    auto starts = std::make_shared<int>(0);
+    auto restarts = std::make_shared<int>(0);
+    auto PoolBot = [starts, restarts](const std::string& cmd) -> std::string {
+        if (cmd.find("START") == 0) { (*starts)++; return "OK"; }
+        if (cmd == "RESTART") { (*restarts)++; return "OK"; }
+        if (cmd == "ABOUT") return "name=\"Bot\" version=\"1.0\"";
+        return "__TIMEOUT__";
+    };
+
+    p.pool = std::make_shared<Sys::ProcessPool>(4);
+    p.process_factory = [=](const std::string&) -> std::unique_ptr<Sys::Process> {
+        return std::make_unique<TestHelpers::MockProcess>(PoolBot);
+    };
+
+    for (int game = 0; game < 2; ++game) {
+        auto r = std::make_shared<Game::Referee>(
+            p, nullptr, stats, TestHelpers::make_handler()
+        );
+        Core::MoveList history;
+        r->step(history);
+        r->finish(0.5);
+    }
+
+    EXPECT_EQ(*starts, 2);
+    EXPECT_EQ(*restarts, 2);
+    EXPECT_EQ(p.pool->stats().reused, 2);
+}
+
+TEST_F(ModularRefereeIntegrationTest, FaultedEngineNotPooled) {
+    auto TimeoutBot = [](const std::string& cmd) -> std::string {
+        if (cmd.find("START") == 0) return "OK";
+        if (cmd == "BEGIN") return "__TIMEOUT__";
+        return "";
+    };
+
+    p.pool = std::make_shared<Sys::ProcessPool>(4);
+    p.p2_cfg.cmd = "p2";
+    SetupBots(TimeoutBot, StandardBot);
+    Core::MoveList history;
+    ref->step(history);
+    EXPECT_EQ(ref->step(history), Game::Referee::Status::FINISHED);
+
+    EXPECT_EQ(p.pool->idle(), 1);
+    EXPECT_EQ(p.pool->acquire(p.pool_key(p.p1_cfg)), nullptr);
+    EXPECT_NE(p.pool->acquire(p.pool_key(p.p2_cfg)), nullptr);
+}
+
+TEST_F(ModularRefereeIntegrationTest, RenjuForbiddenMoveLoses) {
+    struct RecordingProcess : TestHelpers::MockProcess {
+        RecordingProcess(Responder r, std::vector<std::string>& out)
+            : MockProcess(r), sent(out) {}
+        bool write_line(const std::string& line) override {
+            sent.push_back(line);
+            return MockProcess::write_line(line);
+        }
+        std::vector<std::string>& sent;
+    };
+    auto Scripted = [](std::vector<std::string> moves) {
+        auto i = std::make_shared<size_t>(0);
+        return [moves, i](const std::string& cmd) -> std::string {
+            if (cmd.find("START") == 0) return "OK";
+            if (cmd == "ABOUT") return "name=\"Bot\" version=\"1.0\"";
+            return moves[(*i)++ % moves.size()];
+        };
+    };
+
+    std::vector<std::string> sent;
+    p.context->cfg.rule = Core::Rule::RENJU;
+    p.p2_cfg.cmd = "p2";
+    p.process_factory = [&](const std::string& cmd) -> std::unique_ptr<Sys::Process> {
+        if (cmd == "p1") {
+            return std::make_unique<RecordingProcess>(
+                Scripted({"5,7", "6,7", "7,5", "7,6", "7,7"}), sent
+            );
+        }
+        return std::make_unique<TestHelpers::MockProcess>(
+            Scripted({"0,0", "0,2", "0,4", "0,6"})
+        );
+    };
+    double result = -1;
+    ref = std::make_shared<Game::Referee>(
+        p, nullptr, stats,
+        [&](int, int, double r, long, long, long) { result = r; }
+    );
+
+    Core::MoveList history;
+    Game::Referee::Status status = Game::Referee::Status::RUNNING;
+    for (int i = 0; i < 20 && status != Game::Referee::Status::FINISHED; ++i)
+        status = ref->step(history);
+
+    EXPECT_EQ(status, Game::Referee::Status::FINISHED);
+    EXPECT_EQ(history.size(), 9u);
+    EXPECT_EQ(result, 0.0);
+    EXPECT_NE(std::find(sent.begin(), sent.end(), "INFO rule 4"), sent.end());
+}
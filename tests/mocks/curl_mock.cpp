@@ -1,4 +1,5 @@
 #include "curl_mock.h"
+#include <cstdarg>
 #include <cstring>
 #include <map>
 
@@ -156,6 +156,30 @@ echo "$OUT" | grep -q "Starting 2 batch" && pass "-m with 2 values" || fail "-m
 OUT=$(run_arena -1 $BOT -2 $BOT --seed 111,222,333 -M 1 --repeat 3)
 echo "$OUT" | grep -q "Starting 3 batch" && pass "--seed with 3 values" || fail "--seed with 3 values"
 
+OUT=$(run_arena -1 $BOT -2 $BOT -N 100k,200k -M 3 --adaptive --budget 2)
+echo "$OUT" | grep -q "Adaptive scheduler: 2 of 6" && pass "--adaptive --budget" || fail "--adaptive --budget"
+
+OUT=$(run_arena -1 $BOT --engine $BOT --engine "$BOT x" -M 1 -s 15)
+echo "$OUT" | grep -q "Starting 3 batch" && echo "$OUT" | grep -q "Tournament ratings" && pass "--engine round-robin" || fail "--engine round-robin"
+
+OUT=$(run_arena -1 $BOT --engine "$BOT x" -N 100k,200k -M 1 -s 15)
+echo "$OUT" | grep -q "dummy_bot.sh N=100k" && echo "$OUT" | grep -q "dummy_bot.sh N=200k" && pass "tournament rates each node count" || fail "tournament rates each node count"
+
+printf 'Aggression, 50, 0, 100, 5, 0.002\n' > "$TEST_DIR/tune.csv"
+OUT=$(run_arena -1 $BOT -M 2 -s 15 --tune "$TEST_DIR/tune.csv" --tune-checkpoint "$TEST_DIR/tune.ckpt")
+echo "$OUT" | grep -q "SPSA finished at iteration 2/2" && grep -q "# iteration 2" "$TEST_DIR/tune.ckpt" && pass "--tune writes checkpoint" || fail "--tune writes checkpoint"
+OUT=$(run_arena -1 $BOT -M 3 -s 15 --tune "$TEST_DIR/tune.csv" --tune-checkpoint "$TEST_DIR/tune.ckpt")
+echo "$OUT" | grep -q "Resuming SPSA" && echo "$OUT" | grep -q "iteration 3/3" && pass "--tune resumes from checkpoint" || fail "--tune resumes from checkpoint"
+
+OUT=$(run_arena -1 $BOT -2 $BOT -N 100k,200k -m 2 -M 2 -s 15 -j 1 --journal "$TEST_DIR/batch.journal")
+head -5 "$TEST_DIR/batch.journal" > "$TEST_DIR/cut.journal"
+OUT=$(run_arena -1 $BOT -2 $BOT -N 100k,200k -m 2 -M 2 -s 15 -j 1 --journal "$TEST_DIR/cut.journal" --resume)
+echo "$OUT" | grep -q "Restored 4 of 4" && echo "$OUT" | grep -q "Queued 4 games" && pass "--resume skips journaled games" || fail "--resume skips journaled games"
+OUT=$(run_arena -1 $BOT -2 $BOT -M 1 -s 15 --journal "$TEST_DIR/batch.journal")
+echo "$OUT" | grep -q "pass --resume" && pass "--journal refuses to overwrite" || fail "--journal refuses to overwrite"
+OUT=$(run_arena -1 $BOT -2 $BOT -N 100k,200k -M 2 -s 15 --rule 1 --journal "$TEST_DIR/batch.journal" --resume)
+echo "$OUT" | grep -q "different batch" && pass "--resume refuses a changed batch" || fail "--resume refuses a changed batch"
+
 # ============================================================
 section "Batch Expansion: Diagonal vs Cross Product"
 # ============================================================
@@ -235,6 +259,12 @@ echo "$OUT" | grep -q "Starting" && pass "Accepts -r 0" || fail "Accepts -r 0"
 OUT=$(run_arena -1 $BOT -2 $BOT -r 1 -M 1)
 echo "$OUT" | grep -q "Starting" && pass "Accepts -r 1" || fail "Accepts -r 1"
 
+OUT=$(run_arena -1 $BOT -2 $BOT --sprt -5,5 -M 1)
+echo "$OUT" | grep -q "SPRT .*LLR" && pass "Reports SPRT LLR" || fail "Reports SPRT LLR"
+
+OUT=$($ARENA -1 $BOT -2 $BOT --sprt 5,-5 -M 1 2>&1 || true)
+echo "$OUT" | grep -qi "elo1 > elo0" && pass "Rejects --sprt 5,-5" || fail "Rejects --sprt 5,-5"
+
 OUT=$($ARENA -1 $BOT -2 $BOT -M 0 2>&1 || true)
 echo "$OUT" | grep -qi "max-pairs\|must be" && pass "Rejects -M 0" || fail "Rejects -M 0"
 
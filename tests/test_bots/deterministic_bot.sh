@@ -16,6 +16,10 @@ while read line; do
       MOVE_NUM=0
       echo "OK"
       ;;
+    RESTART)
+      MOVE_NUM=0
+      echo "OK"
+      ;;
     BEGIN)
       CENTER=$((BOARD_SIZE / 2))
       echo "${CENTER},${CENTER}"
@@ -12,6 +12,9 @@ while read line; do
       SIZE=$(echo "$line" | awk '{print $2}')
       BOARD_SIZE=${SIZE:-20}
       ;;
+    RESTART)
+      echo "OK"
+      ;;
     BEGIN)
       CENTER=$((BOARD_SIZE / 2))
       echo "${CENTER},${CENTER}"
@@ -0,0 +1,36 @@
+#!/bin/bash
+
+BOARD_SIZE=20
+
+while read line; do
+  cmd=${line%% *}
+  cmd=${cmd^^}
+
+  case "$cmd" in
+    ABOUT)
+      echo 'name="SlowBot", version="1.0"'
+      ;;
+    START)
+      SIZE=${line#* }
+      BOARD_SIZE=${SIZE:-20}
+      echo "OK"
+      ;;
+    BEGIN|TURN|BOARD)
+      if [ "$cmd" = "BOARD" ]; then
+        while read boardline; do
+          if [ "$boardline" = "DONE" ]; then
+            break
+          fi
+        done
+      fi
+      sleep 0.1
+      echo "OK"
+      sleep 0.5
+      CENTER=$((BOARD_SIZE / 2))
+      echo "${CENTER},${CENTER}"
+      ;;
+    END)
+      exit 0
+      ;;
+  esac
+done
@@ -0,0 +1,117 @@
+#include "../common/test_utils.h"
+#include "../src/sys/affinity.h"
+#include <fstream>
+#include <sys/stat.h>
+
+using namespace Arena;
+
+namespace {
+    std::vector<Sys::Affinity::Cpu> grid(int nodes, int cores, int threads) {
+        std::vector<Sys::Affinity::Cpu> cpus;
+        int id = 0;
+        for (int t = 0; t < threads; ++t)
+            for (int n = 0; n < nodes; ++n)
+                for (int c = 0; c < cores; ++c)
+                    cpus.push_back({id++, n * cores + c, n});
+        return cpus;
+    }
+}
+
+TEST(AffinityTest, ParseList) {
+    EXPECT_EQ(Sys::Affinity::parse_list("0-3,8,10-11\n"),
+        (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(Sys::Affinity::parse_list("5"), (std::vector<int>{5}));
+    EXPECT_TRUE(Sys::Affinity::parse_list("").empty());
+}
+
+TEST(AffinityTest, TopologyFromSysfs) {
+    char tmpl[] = "/tmp/arena_sysfs_XXXXXX";
+    ASSERT_NE(mkdtemp(tmpl), nullptr);
+    std::string root = tmpl;
+    std::ofstream(root + "/online") << "0-3\n";
+    for (int id = 0; id < 4; ++id) {
+        std::string cpu = root + "/cpu" + std::to_string(id);
+        mkdir(cpu.c_str(), 0755);
+        mkdir((cpu + "/topology").c_str(), 0755);
+        mkdir((cpu + "/node" + std::to_string(id / 2)).c_str(), 0755);
+        std::ofstream(cpu + "/topology/core_id") << id % 2 << "\n";
+        std::ofstream(cpu + "/topology/physical_package_id") << id / 2 << "\n";
+    }
+
+    auto cpus = Sys::Affinity::topology(root);
+    ASSERT_EQ(cpus.size(), 4u);
+    EXPECT_EQ(cpus[3].id, 3);
+    EXPECT_EQ(cpus[3].node, 1);
+    EXPECT_NE(cpus[0].core, cpus[2].core);
+    EXPECT_EQ(cpus[0].node, 0);
+
+    std::system(("rm -rf " + root).c_str());
+}
+
+TEST(AffinityTest, AllowedIncludesCurrentCpu) {
+    auto cpus = Sys::Affinity::allowed();
+    ASSERT_FALSE(cpus.empty());
+    EXPECT_NE(std::find(cpus.begin(), cpus.end(), sched_getcpu()), cpus.end());
+}
+
+TEST(CoreAllocatorTest, SmtSiblingsShareSlot) {
+    auto alloc = std::make_shared<Sys::CoreAllocator>(grid(1, 2, 2), false);
+    EXPECT_EQ(alloc->slots(), 2u);
+
+    auto lease = alloc->acquire(1);
+    ASSERT_NE(lease, nullptr);
+    EXPECT_EQ(lease->cpus(0), (std::vector<int>{0, 2}));
+    EXPECT_EQ(alloc->available(), 1u);
+}
+
+TEST(CoreAllocatorTest, GameStaysOnOneNode) {
+    auto alloc = std::make_shared<Sys::CoreAllocator>(grid(2, 2, 1), false);
+
+    auto a = alloc->acquire(2);
+    auto b = alloc->acquire(2);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(a->cpus(0).front() / 2, a->cpus(1).front() / 2);
+    EXPECT_EQ(b->cpus(0).front() / 2, b->cpus(1).front() / 2);
+    EXPECT_NE(a->cpus(0).front() / 2, b->cpus(0).front() / 2);
+    EXPECT_FALSE(alloc->can_acquire(1));
+    EXPECT_EQ(alloc->acquire(1), nullptr);
+
+    a.reset();
+    EXPECT_EQ(alloc->available(), 2u);
+    EXPECT_NE(alloc->acquire(2), nullptr);
+}
+
+TEST(CoreAllocatorTest, PrefersTightestNode) {
+    auto alloc = std::make_shared<Sys::CoreAllocator>(grid(2, 3, 1), false);
+    auto hold = alloc->acquire(1);
+    ASSERT_NE(hold, nullptr);
+    EXPECT_EQ(hold->cpus(0), (std::vector<int>{0}));
+
+    auto game = alloc->acquire(2);
+    ASSERT_NE(game, nullptr);
+    EXPECT_EQ(game->cpus(0), (std::vector<int>{1}));
+    EXPECT_EQ(game->cpus(1), (std::vector<int>{2}));
+}
+
+TEST(CoreAllocatorTest, SpansNodesWhenNeeded) {
+    auto alloc = std::make_shared<Sys::CoreAllocator>(grid(2, 1, 1), false);
+    auto game = alloc->acquire(2);
+    ASSERT_NE(game, nullptr);
+    EXPECT_NE(game->cpus(0), game->cpus(1));
+}
+
+TEST(CoreAllocatorTest, Oversubscribe) {
+    auto strict = std::make_shared<Sys::CoreAllocator>(grid(1, 1, 1), false);
+    EXPECT_EQ(strict->acquire(2), nullptr);
+    EXPECT_EQ(strict->available(), 1u);
+
+    auto shared = std::make_shared<Sys::CoreAllocator>(grid(1, 1, 1), true);
+    EXPECT_TRUE(shared->can_acquire(2));
+    auto game = shared->acquire(2);
+    ASSERT_NE(game, nullptr);
+    EXPECT_EQ(game->size(), 2u);
+    EXPECT_EQ(game->cpus(0), game->cpus(1));
+    game.reset();
+    EXPECT_EQ(shared->available(), 1u);
+}
@@ -27,6 +27,25 @@ TEST_F(AppTest, NdjsonFormat) {
     EXPECT_NE(json.find("\"p1_efficiency\":90"), std::string::npos);
 }
 
+TEST_F(AppTest, FormatNdjsonSprt) {
+    Core::BatchConfig bc;
+    bc.p1_cmd = "p1"; bc.p2_cmd = "p2";
+    Core::RunSpec rs;
+    App::MatchState state;
+    Stats::Tracker stats;
+
+    std::string plain = App::format_ndjson_line(bc, rs, state, stats, 1.0, 0.5, 90.0, 80.0);
+    EXPECT_EQ(plain.find("\"llr\""), std::string::npos);
+
+    bc.sprt.enabled = true;
+    state.penta = {1, 2, 3, 4, 5};
+    state.pairs_done = 15;
+    std::string json = App::format_ndjson_line(bc, rs, state, stats, 1.0, 0.5, 90.0, 80.0);
+    EXPECT_NE(json.find("\"llr\":"), std::string::npos);
+    EXPECT_NE(json.find("\"llr_upper\":"), std::string::npos);
+    EXPECT_NE(json.find("\"penta\":[1,2,3,4,5]"), std::string::npos);
+}
+
 TEST_F(AppTest, RunContextLogic) {
     App::RunContext ctx;
     ctx.total_games_expected = 10;
@@ -53,6 +72,29 @@ TEST_F(AppTest, PendingGamesGeneration) {
     EXPECT_EQ(games[1].leg, 1);
 }
 
+TEST_F(AppTest, PendingGamesLeaveRuntimeFieldsUnset) {
+    Core::Config cfg;
+    cfg.max_pairs = 1;
+    cfg.bot1.cmd = "p1";
+    cfg.bot2.cmd = "p2";
+
+    auto ctx = std::make_shared<App::RunContext>();
+    auto games = App::CLI::create_pending_games(cfg, {}, 42, ctx, "id");
+
+    ASSERT_EQ(games.size(), 2);
+    for (const auto& g : games) {
+        EXPECT_EQ(g.context, ctx);
+        EXPECT_EQ(g.run_id, "id");
+        EXPECT_EQ(g.seed, 42u);
+        EXPECT_EQ(g.pool, nullptr);
+        EXPECT_EQ(g.reactor, nullptr);
+        EXPECT_EQ(g.cores, nullptr);
+        EXPECT_FALSE(g.process_factory);
+    }
+    EXPECT_EQ(games[0].p1_cfg.cmd, "p1");
+    EXPECT_EQ(games[1].p1_cfg.cmd, "p2");
+}
+
 TEST_F(AppTest, PendingGamesWithOpenings) {
     Core::Config cfg;
     cfg.max_pairs = 2;
@@ -1,5 +1,8 @@
 #include "../common/test_utils.h"
 #include "../src/analysis/cache.h"
+#include <cstdio>
+#include <sys/mman.h>
+#include <unistd.h>
 
 using namespace Arena;
 
@@ -95,3 +98,124 @@ TEST_F(CacheTest, HashFromMoves) {
 
     EXPECT_NE(h1, h2);
 }
+
+class PersistentCacheTest : public ::testing::Test {
+protected:
+    std::string path = "/tmp/arena_test_eval.cache";
+    Analysis::GlobalCache::Identity id{"rapfi|1|2", 20, 1000000};
+
+    void SetUp() override { std::remove(path.c_str()); }
+    void TearDown() override {
+        Analysis::GlobalCache::close();
+        Analysis::GlobalCache::init(20);
+        std::remove(path.c_str());
+    }
+};
+
+TEST_F(PersistentCacheTest, SurvivesReopen) {
+    ASSERT_TRUE(Analysis::GlobalCache::open(path, id));
+    EXPECT_TRUE(Analysis::GlobalCache::persistent());
+    Analysis::GlobalCache::set(777, {0.7, 0.2, 0.1});
+    Analysis::GlobalCache::close();
+    EXPECT_FALSE(Analysis::GlobalCache::get(777).has_value());
+
+    ASSERT_TRUE(Analysis::GlobalCache::open(path, id));
+    EXPECT_EQ(Analysis::GlobalCache::counters().loaded, 1u);
+    auto res = Analysis::GlobalCache::get(777);
+    ASSERT_TRUE(res.has_value());
+    EXPECT_DOUBLE_EQ(res->p_second, 0.2);
+}
+
+TEST_F(PersistentCacheTest, IdentityChangeStartsEmpty) {
+    ASSERT_TRUE(Analysis::GlobalCache::open(path, id));
+    Analysis::GlobalCache::set(777, {0.7, 0.2, 0.1});
+    Analysis::GlobalCache::close();
+
+    auto other = id;
+    other.eval_nodes = 2000000;
+    ASSERT_TRUE(Analysis::GlobalCache::open(path, other));
+    EXPECT_EQ(Analysis::GlobalCache::counters().loaded, 0u);
+    EXPECT_FALSE(Analysis::GlobalCache::get(777).has_value());
+}
+
+TEST_F(PersistentCacheTest, UncleanFileStartsEmpty) {
+    ASSERT_TRUE(Analysis::GlobalCache::open(path, id));
+    Analysis::GlobalCache::set(777, {0.7, 0.2, 0.1});
+    msync(Analysis::GlobalCache::map_, Analysis::GlobalCache::map_len_, MS_SYNC);
+    munmap(Analysis::GlobalCache::map_, Analysis::GlobalCache::map_len_);
+    ::close(Analysis::GlobalCache::fd_);
+    Analysis::GlobalCache::map_ = nullptr;
+    Analysis::GlobalCache::buckets_ = nullptr;
+
+    ASSERT_TRUE(Analysis::GlobalCache::open(path, id));
+    EXPECT_FALSE(Analysis::GlobalCache::get(777).has_value());
+}
+
+TEST_F(CacheTest, FullBucketEvicts) {
+    const uint64_t ways = Core::Constants::CACHE_BUCKET_WAYS;
+    const uint64_t stride = Analysis::GlobalCache::capacity() / ways;
+    for (uint64_t i = 1; i <= ways; ++i)
+        Analysis::GlobalCache::set(i * stride + 5, {0.1, 0.1, 0.1});
+
+    auto before = Analysis::GlobalCache::counters().evictions;
+    Analysis::GlobalCache::set((ways + 1) * stride + 5, {0.2, 0.2, 0.2});
+
+    EXPECT_EQ(Analysis::GlobalCache::counters().evictions, before + 1);
+    EXPECT_TRUE(Analysis::GlobalCache::get((ways + 1) * stride + 5).has_value());
+}
+
+TEST_F(CacheTest, NodeBudgetIsPartOfKey) {
+    Analysis::GlobalCache::set(4242, {0.3, 0.3, 0.3}, 1000);
+    Analysis::GlobalCache::set(4242, {0.6, 0.6, 0.6}, 2000);
+
+    auto low = Analysis::GlobalCache::get(4242, 1000);
+    auto high = Analysis::GlobalCache::get(4242, 2000);
+    ASSERT_TRUE(low.has_value());
+    ASSERT_TRUE(high.has_value());
+    EXPECT_DOUBLE_EQ(low->p_best, 0.3);
+    EXPECT_DOUBLE_EQ(high->p_best, 0.6);
+    EXPECT_FALSE(Analysis::GlobalCache::get(4242, 3000).has_value());
+}
+
+TEST_F(CacheTest, EvictsSmallestBudgetFirst) {
+    const uint64_t ways = Core::Constants::CACHE_BUCKET_WAYS;
+    const uint64_t stride = Analysis::GlobalCache::capacity() / ways;
+    for (uint64_t i = 1; i <= ways; ++i)
+        Analysis::GlobalCache::set(i * stride + 9, {0.1, 0.1, 0.1}, i == 2 ? 10 : 1000);
+
+    Analysis::GlobalCache::set((ways + 1) * stride + 9, {0.2, 0.2, 0.2}, 1000);
+
+    EXPECT_FALSE(Analysis::GlobalCache::get(2 * stride + 9, 10).has_value());
+    EXPECT_TRUE(Analysis::GlobalCache::get(1 * stride + 9, 1000).has_value());
+    EXPECT_TRUE(Analysis::GlobalCache::get(3 * stride + 9, 1000).has_value());
+}
+
+TEST_F(CacheTest, ConfigurableSize) {
+    Analysis::GlobalCache::init(20, 1000);
+    EXPECT_EQ(Analysis::GlobalCache::capacity(), 512u);
+    Analysis::GlobalCache::init(20);
+    EXPECT_EQ(Analysis::GlobalCache::capacity(), Core::Constants::CACHE_DEFAULT_SIZE);
+}
+
+TEST_F(CacheTest, ConcurrentReadersSeeWholeEntries) {
+    std::atomic<int> torn{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 2; ++t) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < 20000; ++i) {
+                double v = (t * 20000 + i) / 100000.0;
+                Analysis::GlobalCache::set(99, {v, v, v});
+            }
+        });
+    }
+    for (int t = 0; t < 2; ++t) {
+        threads.emplace_back([&torn]() {
+            for (int i = 0; i < 20000; ++i) {
+                auto r = Analysis::GlobalCache::get(99);
+                if (r && (r->p_best != r->p_second || r->p_best != r->p_played)) torn++;
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(torn.load(), 0);
+}
@@ -0,0 +1,46 @@
+#include "../common/test_utils.h"
+#include "../src/sys/cgroup.h"
+#include <fstream>
+#include <sys/stat.h>
+
+using namespace Arena;
+
+TEST(CgroupTest, CpuMax) {
+    EXPECT_EQ(Sys::Cgroup::cpu_max(0), "max 100000");
+    EXPECT_EQ(Sys::Cgroup::cpu_max(1.5), "150000 100000");
+    EXPECT_EQ(Sys::Cgroup::cpu_max(0.001), "1000 100000");
+}
+
+TEST(CgroupTest, InitFailsWithoutCgroupRoot) {
+    EXPECT_FALSE(Sys::Cgroup::init({"/nonexistent/cgroup", 0, ""}));
+    EXPECT_FALSE(Sys::Cgroup::enabled());
+    EXPECT_EQ(Sys::Cgroup::create(1 << 20), nullptr);
+}
+
+TEST(CgroupTest, ReadsAccounting) {
+    char tmpl[] = "/tmp/arena_cgroup_XXXXXX";
+    ASSERT_NE(mkdtemp(tmpl), nullptr);
+    std::string dir = tmpl;
+    std::ofstream(dir + "/cpu.stat") <<
+        "usage_usec 5123456\nuser_usec 4000900\nsystem_usec 1122556\n";
+    std::ofstream(dir + "/memory.peak") << "10485760\n";
+
+    {
+        Sys::Cgroup cg(dir);
+        EXPECT_EQ(cg.cpu_ns(), 5123456000LL);
+        EXPECT_EQ(cg.memory_peak_kb(), 10240);
+
+        std::ofstream(dir + "/cpu.stat") << "usage_usec 6000000\n";
+        EXPECT_EQ(cg.cpu_ns(), 6000000000LL);
+    }
+
+    std::remove((dir + "/cpu.stat").c_str());
+    std::remove((dir + "/memory.peak").c_str());
+    rmdir(dir.c_str());
+}
+
+TEST(CgroupTest, MissingFilesReadAsZero) {
+    Sys::Cgroup cg("/nonexistent/cgroup/bot-1");
+    EXPECT_EQ(cg.cpu_ns(), 0);
+    EXPECT_EQ(cg.memory_peak_kb(), 0);
+}
@@ -160,6 +160,121 @@ TEST_F(CliArgsTest, RiskNegative) {
     EXPECT_THROW(parse(), std::runtime_error);
 }
 
+TEST_F(CliArgsTest, SprtFlags) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("--sprt"); add_arg("-2,3");
+    add_arg("--sprt-alpha"); add_arg("0.01");
+    add_arg("--sprt-beta"); add_arg("0.1");
+
+    auto bc = parse();
+    EXPECT_TRUE(bc.sprt.enabled);
+    EXPECT_DOUBLE_EQ(bc.sprt.elo0, -2.0);
+    EXPECT_DOUBLE_EQ(bc.sprt.elo1, 3.0);
+    EXPECT_DOUBLE_EQ(bc.sprt.alpha, 0.01);
+    EXPECT_DOUBLE_EQ(bc.sprt.beta, 0.1);
+}
+
+TEST_F(CliArgsTest, SprtBoundsOrder) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("--sprt"); add_arg("5,0");
+
+    EXPECT_THROW(parse(), std::runtime_error);
+}
+
+TEST_F(CliArgsTest, SprtAlphaRange) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("--sprt"); add_arg("0,5");
+    add_arg("--sprt-alpha"); add_arg("0.5");
+
+    EXPECT_THROW(parse(), std::runtime_error);
+}
+
+TEST_F(CliArgsTest, SprtExcludesRisk) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("--sprt"); add_arg("0,5");
+    add_arg("-r"); add_arg("0.05");
+
+    EXPECT_THROW(parse(), std::runtime_error);
+}
+
+TEST_F(CliArgsTest, AdaptiveBudget) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("--adaptive");
+    add_arg("--budget"); add_arg("200");
+
+    auto bc = parse();
+    EXPECT_TRUE(bc.adaptive);
+    EXPECT_EQ(bc.budget, 200);
+}
+
+TEST_F(CliArgsTest, BudgetNeedsAdaptive) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("--budget"); add_arg("200");
+
+    EXPECT_THROW(parse(), std::runtime_error);
+}
+
+TEST_F(CliArgsTest, TuneDefaultsSecondPlayer) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("--tune"); add_arg("params.csv");
+    add_arg("--tune-checkpoint"); add_arg("params.ckpt");
+
+    auto bc = parse();
+    EXPECT_EQ(bc.tune_path, "params.csv");
+    EXPECT_EQ(bc.tune_checkpoint, "params.ckpt");
+    EXPECT_EQ(bc.p2_cmd, "p1");
+}
+
+TEST_F(CliArgsTest, TuneRejectsBatches) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("--tune"); add_arg("params.csv");
+    add_arg("-N"); add_arg("1k,2k");
+
+    EXPECT_THROW(parse(), std::runtime_error);
+}
+
+TEST_F(CliArgsTest, TuneRejectsSprt) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("--tune"); add_arg("params.csv");
+    add_arg("--sprt"); add_arg("0,5");
+    add_arg("--risk"); add_arg("0");
+
+    EXPECT_THROW(parse(), std::runtime_error);
+}
+
+TEST_F(CliArgsTest, TuneCheckpointNeedsTune) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("--tune-checkpoint"); add_arg("params.ckpt");
+
+    EXPECT_THROW(parse(), std::runtime_error);
+}
+
+TEST_F(CliArgsTest, JournalResume) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("--journal"); add_arg("batch.journal");
+    add_arg("--resume");
+
+    auto bc = parse();
+    EXPECT_EQ(bc.journal, "batch.journal");
+    EXPECT_TRUE(bc.resume);
+}
+
+TEST_F(CliArgsTest, ResumeNeedsJournal) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("--resume");
+
+    EXPECT_THROW(parse(), std::runtime_error);
+}
+
 TEST_F(CliArgsTest, ApiUrlWithoutKey) {
     add_arg("-1"); add_arg("p1");
     add_arg("-2"); add_arg("p2");
@@ -243,6 +358,65 @@ TEST_F(CliArgsTest, ExpandBatchPerPlayerNodes) {
     EXPECT_EQ(runs.size(), 2);
 }
 
+TEST_F(CliArgsTest, TournamentEngines) {
+    add_arg("-1"); add_arg("base");
+    add_arg("--engine"); add_arg("a");
+    add_arg("--engine"); add_arg("b");
+    add_arg("--tournament"); add_arg("gauntlet");
+
+    auto bc = parse();
+    ASSERT_EQ(bc.engines.size(), 3u);
+    EXPECT_EQ(bc.engines[0], "base");
+    EXPECT_EQ(bc.engines[2], "b");
+    EXPECT_EQ(bc.tournament, Core::Tournament::GAUNTLET);
+    EXPECT_EQ(bc.p1_cmd, "base");
+    EXPECT_EQ(bc.p2_cmd, "a");
+}
+
+TEST_F(CliArgsTest, TournamentDefaultsToRoundRobin) {
+    add_arg("--engine"); add_arg("a");
+    add_arg("--engine"); add_arg("b");
+
+    EXPECT_EQ(parse().tournament, Core::Tournament::ROUND_ROBIN);
+}
+
+TEST_F(CliArgsTest, TournamentNeedsTwoEngines) {
+    add_arg("--engine"); add_arg("a");
+
+    EXPECT_THROW(parse(), std::runtime_error);
+}
+
+TEST_F(CliArgsTest, TournamentRejectsUnknownMode) {
+    add_arg("--engine"); add_arg("a");
+    add_arg("--engine"); add_arg("b");
+    add_arg("--tournament"); add_arg("swiss");
+
+    EXPECT_THROW(parse(), std::runtime_error);
+}
+
+TEST_F(CliArgsTest, ExpandBatchTournament) {
+    Core::BatchConfig bc;
+    bc.engines = {"a", "b", "c", "d"};
+    bc.min_pairs_list = {5};
+    bc.max_pairs_list = {10};
+    bc.common_nodes_list = {1000, 2000};
+
+    bc.tournament = Core::Tournament::GAUNTLET;
+    auto gauntlet = App::CLI::expand_batch(bc);
+    EXPECT_EQ(gauntlet.size(), 6u);
+    for (const auto& r : gauntlet) EXPECT_EQ(r.p1_engine, 0);
+
+    bc.tournament = Core::Tournament::ROUND_ROBIN;
+    auto rr = App::CLI::expand_batch(bc);
+    EXPECT_EQ(rr.size(), 12u);
+    for (const auto& r : rr) {
+        EXPECT_LT(r.p1_engine, r.p2_engine);
+        auto cfg = App::CLI::build_config(bc, r);
+        EXPECT_EQ(cfg.bot1.cmd, bc.engines[r.p1_engine]);
+        EXPECT_EQ(cfg.bot2.cmd, bc.engines[r.p2_engine]);
+    }
+}
+
 TEST_F(CliArgsTest, GenerateConfigLabel) {
     Core::Config cfg;
     cfg.bot1.max_nodes = 1000000;
@@ -324,3 +498,147 @@ TEST_F(CliArgsTest, EvalNodesDefault) {
     ASSERT_GT(runs.size(), 0);
     EXPECT_EQ(runs[0].eval_nodes, 2000000ULL);
 }
+
+TEST_F(CliArgsTest, EngineLifecycleFlags) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("-j"); add_arg("1");
+    add_arg("--concurrency"); add_arg("8");
+    add_arg("--reuse-engines");
+    add_arg("--prespawn"); add_arg("3");
+
+    auto bc = parse();
+    EXPECT_EQ(bc.threads, 1);
+    EXPECT_EQ(bc.concurrency, 8);
+    EXPECT_TRUE(bc.reuse_engines);
+    EXPECT_EQ(bc.prespawn, 3);
+}
+
+TEST_F(CliArgsTest, ConcurrencyDefaultsToThreads) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("-j"); add_arg("1");
+
+    auto bc = parse();
+    EXPECT_EQ(bc.concurrency, 1);
+    EXPECT_FALSE(bc.reuse_engines);
+    EXPECT_EQ(bc.prespawn, 0);
+}
+
+TEST_F(CliArgsTest, EvalServiceFlags) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("-j"); add_arg("1");
+    add_arg("--eval-procs"); add_arg("3");
+    add_arg("--eval-queue"); add_arg("16");
+    add_arg("--eval-idle"); add_arg("5s");
+    add_arg("--eval-cpus"); add_arg("2,3");
+
+    auto bc = parse();
+    EXPECT_EQ(bc.eval_procs, 3);
+    EXPECT_EQ(bc.eval_queue, 16);
+    EXPECT_EQ(bc.eval_idle_ms, 5000);
+    EXPECT_EQ(bc.eval_cpus, (std::vector<int>{2, 3}));
+}
+
+TEST_F(CliArgsTest, EvalProcsDefaultToThreads) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("-j"); add_arg("1");
+
+    auto bc = parse();
+    EXPECT_EQ(bc.eval_procs, 1);
+    EXPECT_TRUE(bc.eval_cpus.empty());
+}
+
+TEST_F(CliArgsTest, EvalGameFlag) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("-j"); add_arg("1");
+    add_arg("--eval-game");
+
+    EXPECT_TRUE(parse().eval_whole_game);
+}
+
+TEST_F(CliArgsTest, EvalCacheFlag) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("--eval-cache"); add_arg("/tmp/evals.cache");
+
+    EXPECT_EQ(parse().eval_cache, "/tmp/evals.cache");
+}
+
+TEST_F(CliArgsTest, EvalCacheRejectsNodeSweep) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("-Ne"); add_arg("1m,2m");
+    add_arg("--eval-cache"); add_arg("/tmp/evals.cache");
+
+    EXPECT_THROW(parse(), std::runtime_error);
+}
+
+TEST_F(CliArgsTest, EvalCacheSize) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("--eval-cache-size"); add_arg("4m");
+
+    EXPECT_EQ(parse().eval_cache_size, 4000000u);
+}
+
+TEST_F(CliArgsTest, Rule) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("--rule"); add_arg("renju");
+
+    auto bc = parse();
+    EXPECT_EQ(bc.rule, Core::Rule::RENJU);
+    EXPECT_EQ(App::CLI::build_config(bc, {}).rule, Core::Rule::RENJU);
+}
+
+TEST_F(CliArgsTest, UnknownRule) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("--rule"); add_arg("caro");
+
+    EXPECT_THROW(parse(), std::runtime_error);
+}
+
+TEST_F(CliArgsTest, Cgroup) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("--cgroup"); add_arg("/sys/fs/cgroup/arena");
+    add_arg("--cgroup-cpus"); add_arg("1.5");
+    add_arg("--cgroup-cpuset"); add_arg("0-3");
+
+    auto bc = parse();
+    EXPECT_EQ(bc.cgroup, "/sys/fs/cgroup/arena");
+    EXPECT_DOUBLE_EQ(bc.cgroup_cpus, 1.5);
+    EXPECT_EQ(bc.cgroup_cpuset, "0-3");
+}
+
+TEST_F(CliArgsTest, CgroupLimitsNeedCgroup) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("--cgroup-cpus"); add_arg("1");
+
+    EXPECT_THROW(parse(), std::runtime_error);
+}
+
+TEST_F(CliArgsTest, PinFlags) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("--pin");
+    add_arg("--oversubscribe");
+
+    auto bc = parse();
+    EXPECT_TRUE(bc.pin);
+    EXPECT_TRUE(bc.oversubscribe);
+}
+
+TEST_F(CliArgsTest, OversubscribeNeedsPin) {
+    add_arg("-1"); add_arg("p1");
+    add_arg("-2"); add_arg("p2");
+    add_arg("--oversubscribe");
+
+    EXPECT_THROW(parse(), std::runtime_error);
+}
@@ -54,3 +54,26 @@ TEST(CpuMonitorTest, NonExistentPid) {
     EXPECT_EQ(times.user_ms, 0);
     EXPECT_EQ(times.sys_ms, 0);
 }
+
+TEST(CpuMonitorTest, LoadFromNanoseconds) {
+    EXPECT_NEAR(Sys::CpuMonitor::calculate_load(25000000LL, 50000000LL), 50.0, 1e-9);
+    EXPECT_DOUBLE_EQ(Sys::CpuMonitor::calculate_load(1000LL, 0LL), 0.0);
+}
+
+TEST(CpuClockTest, SelfAdvancesBelowTickResolution) {
+    auto clock = Sys::CpuClock::self();
+    ASSERT_TRUE(clock.valid());
+    long long start = clock.ns();
+    volatile long x = 0;
+    while (clock.ns() - start < 1000000) x++;
+    long long spent = clock.ns() - start;
+    EXPECT_GE(spent, 1000000);
+    EXPECT_LT(spent, 10000000);
+}
+
+TEST(CpuClockTest, InvalidPid) {
+    Sys::CpuClock clock(-1);
+    EXPECT_FALSE(clock.valid());
+    EXPECT_EQ(clock.ns(), 0);
+    EXPECT_EQ(Sys::CpuClock().ns(), 0);
+}
@@ -0,0 +1,275 @@
+#include "../common/test_utils.h"
+#include "../src/app/eval_service.h"
+#include "../src/analysis/cache.h"
+#include "../src/sys/signals.h"
+#include <atomic>
+#include <thread>
+
+using namespace Arena;
+
+class EvalServiceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Analysis::GlobalCache::init(15);
+        ctx = std::make_shared<App::RunContext>();
+        ctx->cfg.board_size = 15;
+        ctx->cfg.eval_path = "mock";
+    }
+
+    void TearDown() override {
+        Sys::g_stop_flag = 0;
+    }
+
+    App::EvalService::Options options(std::atomic<int>* evals = nullptr) {
+        App::EvalService::Options o;
+        o.cmd = "mock";
+        o.board_size = 15;
+        o.timeout_cutoff = 1000;
+        o.max_nodes = 1000;
+        o.procs = 2;
+        o.process_factory = [evals](const std::string&) {
+            return std::make_unique<TestHelpers::MockProcess>(
+                [evals](const std::string& cmd) -> std::string {
+                    if (cmd.find("START") == 0) return "OK";
+                    if (cmd.find("ANALYZE_MOVE") == 0) {
+                        if (evals) (*evals)++;
+                        return "EVAL_DATA 0.9 0.1 0.5";
+                    }
+                    if (cmd == "DONE") return "ERROR Unknown command: ANALYZE_GAME";
+                    return "";
+                }
+            );
+        };
+        return o;
+    }
+
+    App::EvalJob job(int x, int y) {
+        return {{{x, y}}, 1, ctx, 1000};
+    }
+
+    std::shared_ptr<App::RunContext> ctx;
+};
+
+TEST_F(EvalServiceTest, ProcessesSubmittedJobs) {
+    std::atomic<int> evals{0};
+    App::EvalService svc(options(&evals));
+    svc.start();
+
+    for (int i = 0; i < 10; ++i) EXPECT_TRUE(svc.submit(job(1 + i % 6 + i / 6, i / 6)));
+    svc.drain();
+
+    EXPECT_EQ(svc.pending(), 0u);
+    EXPECT_EQ(svc.stats().jobs, 10u);
+    EXPECT_EQ(evals.load(), 10);
+    EXPECT_EQ(ctx->stats.p1_moves_analyzed, 10);
+    EXPECT_LE(svc.stats().spawns, 2u);
+    svc.stop();
+}
+
+TEST_F(EvalServiceTest, CachedPositionsSkipEngine) {
+    std::atomic<int> evals{0};
+    App::EvalService svc(options(&evals));
+    svc.start();
+
+    svc.submit(job(3, 3));
+    svc.drain();
+    svc.submit(job(3, 3));
+    svc.drain();
+
+    EXPECT_EQ(evals.load(), 1);
+    EXPECT_EQ(svc.stats().cache_hits, 1u);
+    EXPECT_EQ(ctx->stats.p1_moves_analyzed, 2);
+}
+
+TEST_F(EvalServiceTest, SymmetricPositionsShareCache) {
+    std::atomic<int> evals{0};
+    App::EvalService svc(options(&evals));
+    svc.start();
+
+    svc.submit({{{7, 7}, {8, 9}}, 1, ctx, 1000});
+    svc.drain();
+    svc.submit({{{7, 7}, {6, 9}}, 1, ctx, 1000});
+    svc.submit({{{7, 7}, {9, 8}}, 1, ctx, 1000});
+    svc.drain();
+
+    EXPECT_EQ(evals.load(), 1);
+    EXPECT_EQ(svc.stats().cache_hits, 2u);
+}
+
+TEST_F(EvalServiceTest, IdleEvaluatorsShutDown) {
+    auto o = options();
+    o.procs = 1;
+    o.idle_ms = 50;
+    App::EvalService svc(o);
+    svc.start();
+
+    svc.submit(job(1, 2));
+    svc.drain();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_EQ(svc.stats().idle_shutdowns, 1u);
+
+    svc.submit(job(2, 1));
+    svc.drain();
+    EXPECT_EQ(svc.stats().spawns, 2u);
+}
+
+TEST_F(EvalServiceTest, BoundedQueueBlocksUntilDrained) {
+    auto o = options();
+    o.queue_max = 1;
+    App::EvalService svc(o);
+
+    EXPECT_TRUE(svc.submit(job(4, 4)));
+    EXPECT_EQ(svc.pending(), 1u);
+
+    std::atomic<bool> done{false};
+    std::thread producer([&]() {
+        svc.submit(job(5, 5));
+        done = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(done.load());
+
+    svc.start();
+    producer.join();
+    svc.drain();
+    EXPECT_EQ(svc.stats().jobs, 2u);
+}
+
+TEST_F(EvalServiceTest, NonBlockingSubmitOvershootsBound) {
+    auto o = options();
+    o.queue_max = 1;
+    App::EvalService svc(o);
+
+    EXPECT_FALSE(svc.saturated());
+    EXPECT_TRUE(svc.submit(job(7, 7), false));
+    EXPECT_TRUE(svc.saturated());
+    EXPECT_TRUE(svc.submit(job(8, 8), false));
+    EXPECT_EQ(svc.pending(), 2u);
+
+    svc.start();
+    svc.drain();
+    EXPECT_FALSE(svc.saturated());
+    EXPECT_EQ(svc.queue_wait().summary().count, 2u);
+}
+
+TEST_F(EvalServiceTest, GamesStickToOneEvaluator) {
+    App::EvalService svc(options());
+    svc.start();
+
+    Core::MoveList a = {{1, 1}, {1, 2}, {1, 3}, {1, 4}, {1, 5}};
+    Core::MoveList b = {{9, 1}, {9, 2}, {9, 3}, {9, 4}, {9, 5}};
+    for (size_t n = 2; n <= a.size(); ++n) {
+        svc.submit({a.prefix(n), 1, ctx, 1000, 1});
+        svc.submit({b.prefix(n), 1, ctx, 1000, 2});
+    }
+    svc.drain();
+    svc.end_game(1);
+    svc.end_game(2);
+
+    auto st = svc.stats();
+    EXPECT_EQ(st.jobs, 8u);
+    EXPECT_EQ(st.full_syncs, 2u);
+    EXPECT_EQ(st.delta_syncs, 6u);
+    EXPECT_TRUE(svc.owners_.empty());
+}
+
+TEST_F(EvalServiceTest, WholeGameJobRecordsEveryPly) {
+    auto o = options();
+    o.procs = 1;
+    o.process_factory = [](const std::string&) {
+        auto ply = std::make_shared<int>(5);
+        return std::make_unique<TestHelpers::MockProcess>(
+            [ply](const std::string& cmd) -> std::string {
+                if (cmd != "DONE") return "OK";
+                if (*ply < 3) return "DONE";
+                return "EVAL_DATA 0.9 0.1 0.5 " + std::to_string((*ply)--);
+            }
+        );
+    };
+    App::EvalService svc(o);
+    svc.start();
+
+    App::EvalJob j{{{2, 1}, {2, 2}, {2, 3}, {2, 4}, {2, 5}}, 1, ctx, 1000, 9, true, 2};
+    svc.submit(j);
+    svc.drain();
+
+    EXPECT_EQ(svc.stats().whole_games, 1u);
+    EXPECT_EQ(ctx->stats.p1_moves_analyzed, 2);
+    EXPECT_EQ(ctx->stats.p2_moves_analyzed, 1);
+}
+
+TEST_F(EvalServiceTest, WholeGameFallsBackPerPly) {
+    std::atomic<int> evals{0};
+    auto o = options(&evals);
+    o.procs = 1;
+    App::EvalService svc(o);
+    svc.start();
+
+    App::EvalJob j{{{3, 1}, {3, 2}, {3, 3}, {3, 4}}, 2, ctx, 1000, 9, true, 1};
+    svc.submit(j);
+    svc.drain();
+
+    EXPECT_EQ(svc.stats().whole_games, 0u);
+    EXPECT_EQ(evals.load(), 3);
+    EXPECT_EQ(ctx->stats.p1_moves_analyzed, 1);
+    EXPECT_EQ(ctx->stats.p2_moves_analyzed, 2);
+}
+
+TEST_F(EvalServiceTest, UsesAttachedPositionKeys) {
+    std::atomic<int> evals{0};
+    App::EvalService svc(options(&evals));
+    svc.start();
+
+    Analysis::GlobalCache::set(0x5eed, {0.9, 0.1, 0.5}, 1000);
+    App::EvalJob j = job(2, 3);
+    j.keys = {0x5eed};
+    svc.submit(j);
+    svc.drain();
+
+    EXPECT_EQ(evals.load(), 0);
+    EXPECT_EQ(svc.stats().cache_hits, 1u);
+}
+
+TEST_F(EvalServiceTest, WholeGameUsesAttachedPositionKeys) {
+    std::atomic<int> evals{0};
+    App::EvalService svc(options(&evals));
+    svc.start();
+
+    Analysis::GlobalCache::set(0x5eee, {0.9, 0.1, 0.5}, 1000);
+    Analysis::GlobalCache::set(0x5eef, {0.9, 0.1, 0.5}, 1000);
+    App::EvalJob j{{{4, 1}, {4, 2}, {4, 3}}, 1, ctx, 1000, 11, true, 1};
+    j.keys = {0x5eed, 0x5eee, 0x5eef};
+    svc.submit(j);
+    svc.drain();
+
+    EXPECT_EQ(evals.load(), 0);
+    EXPECT_EQ(svc.stats().cache_hits, 2u);
+}
+
+TEST_F(EvalServiceTest, SubmitFailsAfterStop) {
+    App::EvalService svc(options());
+    svc.start();
+    svc.stop();
+    EXPECT_FALSE(svc.submit(job(6, 6)));
+}
+
+TEST_F(EvalServiceTest, ReportsRunDrainedOnLastJob) {
+    std::atomic<int> drained{0};
+    auto o = options();
+    o.on_drained = [&](const std::shared_ptr<App::RunContext>& c) {
+        EXPECT_EQ(c, ctx);
+        EXPECT_EQ(c->evals_pending.load(), 0);
+        drained++;
+    };
+    App::EvalService svc(std::move(o));
+
+    for (int i = 0; i < 4; ++i) EXPECT_TRUE(svc.submit(job(2 + i, 2)));
+    EXPECT_EQ(ctx->evals_pending.load(), 4);
+    svc.start();
+    svc.drain();
+
+    EXPECT_EQ(ctx->evals_pending.load(), 0);
+    EXPECT_EQ(ctx->stats.p1_moves_analyzed, 4);
+    EXPECT_EQ(drained.load(), 1);
+    svc.stop();
+}
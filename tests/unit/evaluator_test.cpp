@@ -1,6 +1,8 @@
 #include "../common/test_utils.h"
 #include "../src/analysis/evaluator.h"
 #include "../src/sys/signals.h"
+#include <algorithm>
+#include <deque>
 
 using namespace Arena;
 
@@ -104,3 +106,174 @@ TEST_F(EvaluatorTest, ExitOnCrashFlagOff) {
     auto res = eval.eval(moves);
     EXPECT_DOUBLE_EQ(res.p_best, 0.5);
 }
+
+class RecordingProcess : public TestHelpers::MockProcess {
+public:
+    RecordingProcess(Responder r, std::vector<std::string>& log) :
+        TestHelpers::MockProcess(r), log_(log) {}
+
+    bool write_line(const std::string& line) override {
+        log_.push_back(line);
+        return TestHelpers::MockProcess::write_line(line);
+    }
+
+private:
+    std::vector<std::string>& log_;
+};
+
+static size_t count_prefix(const std::vector<std::string>& log, const std::string& p) {
+    return std::count_if(log.begin(), log.end(), [&](const std::string& l) {
+        return l.rfind(p, 0) == 0;
+    });
+}
+
+TEST_F(EvaluatorTest, DeltaSyncSendsOnlyNewMoves) {
+    std::vector<std::string> log;
+    auto responder = [](const std::string& cmd) -> std::string {
+        if (cmd.find("START") == 0) return "OK";
+        if (cmd.find("ANALYZE_MOVE") == 0) return "EVAL_DATA 0.9 0.1 0.5";
+        return "OK";
+    };
+    Analysis::Evaluator eval("dummy", 15, 1000, false, 1000,
+        std::make_unique<RecordingProcess>(responder, log));
+    ASSERT_TRUE(eval.start());
+
+    std::vector<Core::Point> moves = {{7, 7}, {7, 8}, {8, 8}, {9, 9}, {6, 6}};
+    for (size_t n = 2; n <= moves.size(); ++n) {
+        std::vector<Core::Point> hist(moves.begin(), moves.begin() + n);
+        EXPECT_DOUBLE_EQ(eval.eval(hist).p_best, 0.9);
+    }
+
+    EXPECT_EQ(count_prefix(log, "YXBOARD"), 1u);
+    EXPECT_EQ(count_prefix(log, "PLACE"), 3u);
+    EXPECT_EQ(eval.full_syncs(), 1u);
+    EXPECT_EQ(eval.delta_syncs(), 3u);
+    EXPECT_EQ(eval.synced().size(), moves.size() - 1);
+}
+
+TEST_F(EvaluatorTest, DivergentPositionTakesBack) {
+    std::vector<std::string> log;
+    auto responder = [](const std::string& cmd) -> std::string {
+        if (cmd.find("ANALYZE_MOVE") == 0) return "EVAL_DATA 0.9 0.1 0.5";
+        return "OK";
+    };
+    Analysis::Evaluator eval("dummy", 15, 1000, false, 1000,
+        std::make_unique<RecordingProcess>(responder, log));
+    ASSERT_TRUE(eval.start());
+
+    eval.eval({{7, 7}, {7, 8}, {8, 8}, {9, 9}, {1, 1}});
+    log.clear();
+    eval.eval({{7, 7}, {7, 8}, {8, 8}, {2, 2}, {1, 1}});
+
+    ASSERT_EQ(log.size(), 3u);
+    EXPECT_EQ(log[0], "TAKEBACK 9,9");
+    EXPECT_EQ(log[1], "PLACE 2,2");
+    EXPECT_EQ(log[2], "ANALYZE_MOVE 1,1");
+}
+
+TEST_F(EvaluatorTest, ErrorReplyFallsBackToFullSync) {
+    std::vector<std::string> log;
+    int analyses = 0;
+    auto responder = [&](const std::string& cmd) -> std::string {
+        if (cmd.find("ANALYZE_MOVE") == 0) {
+            if (++analyses == 2) return "ERROR Unknown command: PLACE";
+            return "EVAL_DATA 0.7 0.1 0.5";
+        }
+        return "OK";
+    };
+    Analysis::Evaluator eval("dummy", 15, 1000, false, 1000,
+        std::make_unique<RecordingProcess>(responder, log));
+    ASSERT_TRUE(eval.start());
+
+    eval.eval({{7, 7}, {7, 8}});
+    auto res = eval.eval({{7, 7}, {7, 8}, {8, 8}});
+    EXPECT_DOUBLE_EQ(res.p_best, 0.7);
+    EXPECT_EQ(count_prefix(log, "YXBOARD"), 2u);
+
+    eval.eval({{7, 7}, {7, 8}, {8, 8}, {9, 9}});
+    EXPECT_EQ(count_prefix(log, "YXBOARD"), 3u);
+    EXPECT_EQ(count_prefix(log, "PLACE"), 1u);
+}
+
+TEST_F(EvaluatorTest, WholeGameStreamsPerPly) {
+    std::vector<std::string> log;
+    std::deque<std::string> replies = {
+        "EVAL_DATA 0.8 0.2 0.4 3", "MESSAGE thinking", "EVAL_DATA 0.7 0.3 0.5 2", "DONE"
+    };
+    auto responder = [&](const std::string& cmd) -> std::string {
+        if (cmd == "DONE" && !replies.empty()) {
+            auto r = replies.front();
+            replies.pop_front();
+            return r;
+        }
+        return "OK";
+    };
+    Analysis::Evaluator eval("dummy", 15, 1000, false, 1000,
+        std::make_unique<RecordingProcess>(responder, log));
+    ASSERT_TRUE(eval.start());
+    log.clear();
+
+    auto res = eval.eval_game({{7, 7}, {7, 8}, {8, 8}}, 2);
+    ASSERT_TRUE(res.has_value());
+    ASSERT_EQ(res->size(), 4u);
+    EXPECT_DOUBLE_EQ((*res)[3].p_best, 0.8);
+    EXPECT_DOUBLE_EQ((*res)[3].p_played, 0.4);
+    EXPECT_DOUBLE_EQ((*res)[2].p_best, 0.7);
+    EXPECT_EQ(log.front(), "ANALYZE_GAME 2");
+    EXPECT_EQ(log.back(), "DONE");
+    EXPECT_EQ(eval.synced().size(), 1u);
+}
+
+TEST_F(EvaluatorTest, WholeGameUnsupported) {
+    auto responder = [](const std::string& cmd) -> std::string {
+        if (cmd == "DONE") return "ERROR Unknown command: ANALYZE_GAME";
+        return "OK";
+    };
+    Analysis::Evaluator eval("dummy", 15, 1000, false, 1000,
+        std::make_unique<TestHelpers::MockProcess>(responder));
+    ASSERT_TRUE(eval.start());
+
+    EXPECT_FALSE(eval.eval_game({{7, 7}, {7, 8}}, 1).has_value());
+    EXPECT_FALSE(eval.game_supported());
+    EXPECT_FALSE(eval.eval_game({{7, 7}, {7, 8}}, 1).has_value());
+}
+
+TEST_F(EvaluatorTest, WholeGameTimeoutRestarts) {
+    std::vector<std::string> log;
+    std::deque<std::string> replies = {"EVAL_DATA 0.8 0.2 0.4 2", "__TIMEOUT__"};
+    auto responder = [&](const std::string& cmd) -> std::string {
+        if (cmd == "DONE" && !replies.empty()) {
+            auto r = replies.front();
+            replies.pop_front();
+            return r;
+        }
+        return "OK";
+    };
+    Analysis::Evaluator eval("dummy", 15, 100, false, 1000,
+        std::make_unique<RecordingProcess>(responder, log));
+    ASSERT_TRUE(eval.start());
+    log.clear();
+
+    EXPECT_FALSE(eval.eval_game({{7, 7}, {7, 8}, {8, 8}}, 2).has_value());
+    EXPECT_EQ(count_prefix(log, "START"), 1u);
+    EXPECT_TRUE(eval.game_supported());
+}
+
+TEST_F(EvaluatorTest, MoveParseSkipsWholeGameLines) {
+    std::deque<std::string> replies = {"EVAL_DATA 0.8 0.2 0.4 3", "EVAL_DATA 0.6 0.3 0.5"};
+    auto responder = [&](const std::string& cmd) -> std::string {
+        if (cmd.find("ANALYZE_MOVE") == 0 && !replies.empty()) {
+            auto r = replies.front();
+            replies.pop_front();
+            return r;
+        }
+        return "OK";
+    };
+    Analysis::Evaluator eval("dummy", 15, 1000, false, 1000,
+        std::make_unique<TestHelpers::MockProcess>(responder));
+    ASSERT_TRUE(eval.start());
+
+    auto res = eval.eval({{7, 7}, {7, 8}});
+    EXPECT_DOUBLE_EQ(res.p_best, 0.6);
+    EXPECT_DOUBLE_EQ(res.p_played, 0.5);
+}
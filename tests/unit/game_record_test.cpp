@@ -0,0 +1,58 @@
+#include "../common/test_utils.h"
+#include "../src/core/game_record.h"
+
+using namespace Arena;
+
+TEST(GameRecordTest, SizedToBoard) {
+    auto rec = Core::GameRecord::for_board(15);
+    EXPECT_EQ(rec->capacity(), 225u);
+    EXPECT_EQ(rec->size(), 0u);
+}
+
+TEST(GameRecordTest, PushStoresCoordinates) {
+    auto rec = Core::GameRecord::for_board(20);
+    rec->push({19, 0});
+    rec->push({3, 17});
+
+    ASSERT_EQ(rec->size(), 2u);
+    EXPECT_EQ((*rec)[0], (Core::Point{19, 0}));
+    EXPECT_EQ((*rec)[1], (Core::Point{3, 17}));
+}
+
+TEST(GameRecordTest, PushPastCapacityThrows) {
+    Core::GameRecord rec(1);
+    rec.push({0, 0});
+    EXPECT_THROW(rec.push({1, 1}), std::length_error);
+}
+
+TEST(GameRecordTest, ListSharesRecord) {
+    auto rec = Core::GameRecord::for_board(15);
+    rec->push({7, 7});
+    Core::MoveList early(rec, rec->size());
+    rec->push({8, 8});
+    rec->push({9, 9});
+    Core::MoveList late(rec, rec->size());
+
+    EXPECT_EQ(early.record(), late.record());
+    EXPECT_EQ(early.size(), 1u);
+    EXPECT_EQ(early.back(), (Core::Point{7, 7}));
+    EXPECT_EQ(late.size(), 3u);
+    EXPECT_EQ(late.back(), (Core::Point{9, 9}));
+}
+
+TEST(GameRecordTest, PrefixIsClamped) {
+    Core::MoveList moves = {{1, 1}, {2, 2}, {3, 3}};
+    EXPECT_EQ(moves.prefix(2).size(), 2u);
+    EXPECT_EQ(moves.prefix(2).back(), (Core::Point{2, 2}));
+    EXPECT_EQ(moves.prefix(9).size(), 3u);
+    EXPECT_EQ(moves.prefix(2).record(), moves.record());
+}
+
+TEST(GameRecordTest, ToVector) {
+    Core::MoveList moves = {{1, 1}, {2, 2}, {3, 3}};
+    auto v = moves.to_vector(2);
+    ASSERT_EQ(v.size(), 2u);
+    EXPECT_EQ(v[1], (Core::Point{2, 2}));
+    EXPECT_EQ(moves.to_vector().size(), 3u);
+    EXPECT_TRUE(Core::MoveList().empty());
+}
@@ -0,0 +1,180 @@
+#include "../common/test_utils.h"
+#include "../src/app/journal.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+using namespace Arena;
+
+class JournalTest : public ::testing::Test {
+protected:
+    std::string path = "/tmp/arena_test_journal.log";
+
+    void SetUp() override { std::remove(path.c_str()); }
+    void TearDown() override { std::remove(path.c_str()); }
+
+    Core::RunSpec spec(uint64_t nodes = 1000) {
+        Core::RunSpec rs;
+        rs.p1_nodes = rs.p2_nodes = nodes;
+        rs.max_pairs = 4;
+        return rs;
+    }
+};
+
+TEST_F(JournalTest, KeyDependsOnSpec) {
+    EXPECT_EQ(App::Journal::key(spec()), App::Journal::key(spec()));
+    EXPECT_NE(App::Journal::key(spec(1000)), App::Journal::key(spec(2000)));
+
+    auto a = spec(), b = spec();
+    b.repeat_index = 1;
+    EXPECT_NE(App::Journal::key(a), App::Journal::key(b));
+    b = spec();
+    b.seed = 7;
+    EXPECT_NE(App::Journal::key(a), App::Journal::key(b));
+    EXPECT_EQ(App::Journal::key(a).find(' '), std::string::npos);
+}
+
+TEST_F(JournalTest, ReplaysFinishedGames) {
+    auto key = App::Journal::key(spec());
+    uint64_t seed;
+    {
+        App::Journal j(path, "batch", false);
+        seed = j.seed();
+        Stats::Tracker a, b, c;
+        a.add_metrics(1, 0.1, 0.0);
+        j.record_game(key, 1, 0, 1.0, 100, a);
+        b.add_crash(2);
+        b.add_metrics(2, 0.2, 0.0);
+        j.record_game(key, 1, 1, 0.5, 200, b);
+        j.record_game(key, 2, 0, 0.0, 50, c);
+    }
+
+    App::Journal j(path, "batch", true);
+    EXPECT_EQ(j.seed(), seed);
+    EXPECT_EQ(j.loaded(), 3u);
+    EXPECT_FALSE(j.finished(key));
+
+    App::RunContext ctx;
+    EXPECT_EQ(j.replay(key, ctx), 2);
+    EXPECT_EQ(ctx.games_completed, 3);
+    EXPECT_EQ(ctx.total_wall_time_ms, 350);
+    EXPECT_EQ(ctx.match_state.pairs_done, 1);
+    EXPECT_EQ(ctx.match_state.wins, 1);
+    EXPECT_EQ(ctx.match_state.penta[3], 1);
+    EXPECT_DOUBLE_EQ(ctx.match_state.results[2].first, 0.0);
+    EXPECT_LT(ctx.match_state.results[2].second, Core::Constants::PAIR_RESULT_THRESHOLD);
+    EXPECT_EQ(ctx.stats.games, 3);
+    EXPECT_EQ(ctx.stats.p2_crashes, 1);
+    EXPECT_EQ(ctx.stats.p1_moves_analyzed, 1);
+    EXPECT_EQ(ctx.stats.p2_moves_analyzed, 1);
+    Stats::Tracker elo;
+    elo.update_elo(1.0);
+    elo.update_elo(0.5);
+    elo.update_elo(0.0);
+    EXPECT_EQ(ctx.stats.p1_elo, elo.p1_elo);
+
+    App::RunContext other;
+    EXPECT_EQ(j.replay(App::Journal::key(spec(2000)), other), 0);
+    EXPECT_EQ(other.games_completed, 0);
+}
+
+TEST_F(JournalTest, RecordsFinishedRuns) {
+    auto key = App::Journal::key(spec());
+    {
+        App::Journal j(path, "batch", false);
+        Stats::Tracker st;
+        j.record_game(key, 1, 0, 1.0, 10, st);
+        st.update_elo(1.0);
+        j.record_finish(key, st);
+    }
+    App::Journal j(path, "batch", true);
+    EXPECT_TRUE(j.finished(key));
+    App::RunContext ctx;
+    j.replay(key, ctx);
+    EXPECT_EQ(ctx.stats.games, 1);
+}
+
+TEST_F(JournalTest, TruncatesTornLastRecord) {
+    auto key = App::Journal::key(spec());
+    {
+        App::Journal j(path, "batch", false);
+        j.record_game(key, 1, 0, 1.0, 10, Stats::Tracker{});
+    }
+    std::ifstream in(path);
+    std::string intact((std::istreambuf_iterator<char>(in)), {});
+    in.close();
+    {
+        std::ofstream out(path, std::ios::app);
+        out << "G " << key << " 1 1 0.5 12";
+    }
+
+    {
+        App::Journal j(path, "batch", true);
+        EXPECT_EQ(j.loaded(), 1u);
+    }
+    std::ifstream after(path);
+    std::string text((std::istreambuf_iterator<char>(after)), {});
+    EXPECT_EQ(text, intact);
+
+    {
+        App::Journal j(path, "batch", true);
+        EXPECT_EQ(j.loaded(), 1u);
+        j.record_game(key, 1, 1, 0.0, 10, Stats::Tracker{});
+    }
+    App::Journal j(path, "batch", true);
+    EXPECT_EQ(j.loaded(), 2u);
+    App::RunContext ctx;
+    EXPECT_EQ(j.replay(key, ctx), 1);
+    EXPECT_EQ(ctx.match_state.wins, 1);
+    EXPECT_DOUBLE_EQ(ctx.match_state.results[1].second, 0.0);
+}
+
+TEST_F(JournalTest, TruncatesTornHeader) {
+    {
+        std::ofstream out(path);
+        out << "# arena jour";
+    }
+    App::Journal j(path, "batch", true);
+    EXPECT_EQ(j.loaded(), 0u);
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    EXPECT_EQ(line.rfind("# arena journal seed " + std::to_string(j.seed()) + " batch ", 0), 0u);
+}
+
+TEST_F(JournalTest, RefusesToOverwriteWithoutResume) {
+    { App::Journal j(path, "batch", false); }
+    EXPECT_THROW(App::Journal(path, "batch", false), std::runtime_error);
+    EXPECT_NO_THROW(App::Journal(path, "batch", true));
+}
+
+TEST_F(JournalTest, RefusesDifferentBatch) {
+    { App::Journal j(path, "engines a b", false); }
+    EXPECT_THROW(App::Journal(path, "engines a c", true), std::runtime_error);
+    EXPECT_NO_THROW(App::Journal(path, "engines a b", true));
+}
+
+TEST_F(JournalTest, HoldsGameUntilEvalsSettle) {
+    auto key = App::Journal::key(spec());
+    {
+        App::RunContext ctx;
+        ctx.journal = std::make_shared<App::Journal>(path, "batch", false);
+        ctx.journal_key = key;
+        auto tally = std::make_shared<App::GameTally>();
+        tally->pair = 1;
+        tally->p1_score = 1.0;
+        tally->pending++;
+
+        App::settle_game(ctx, tally);
+        tally->stats.add_metrics(1, 0.3, 0.0);
+        EXPECT_EQ(App::Journal(path, "batch", true).loaded(), 0u);
+
+        App::settle_game(ctx, tally);
+    }
+    App::Journal j(path, "batch", true);
+    EXPECT_EQ(j.loaded(), 1u);
+    App::RunContext ctx;
+    j.replay(key, ctx);
+    EXPECT_EQ(ctx.stats.p1_moves_analyzed, 1);
+    EXPECT_EQ(ctx.stats.games, 1);
+}
@@ -0,0 +1,96 @@
+#include "../common/test_utils.h"
+#include "../src/sys/launcher.h"
+#include "../src/sys/process.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <sys/wait.h>
+
+using namespace Arena;
+
+TEST(LauncherTest, CachesParsedCommand) {
+    auto a = Sys::Launcher::command("echo cached 'two words'");
+    auto b = Sys::Launcher::command("echo cached 'two words'");
+    EXPECT_EQ(a, b);
+    ASSERT_EQ(a->args.size(), 3u);
+    EXPECT_EQ(a->args[2], "two words");
+    ASSERT_EQ(a->argv.size(), 4u);
+    EXPECT_EQ(a->argv.back(), nullptr);
+}
+
+TEST(LauncherTest, ResolvesPathOnce) {
+    auto c = Sys::Launcher::command("echo");
+    EXPECT_NE(c->path.find('/'), std::string::npos);
+    EXPECT_EQ(access(c->path.c_str(), X_OK), 0);
+}
+
+TEST(LauncherTest, EnvOverridesInheritedValue) {
+    Sys::Process proc("printenv HOME");
+    ASSERT_TRUE(proc.start(0, {{"HOME", "/override"}}));
+    auto line = proc.read_line(1000, nullptr);
+    ASSERT_TRUE(line.has_value());
+    EXPECT_EQ(*line, "/override");
+}
+
+TEST(LauncherTest, AppliesMemoryLimit) {
+    Sys::Process proc("sh -c 'ulimit -v'");
+    ASSERT_TRUE(proc.start(512LL * 1024 * 1024));
+    auto line = proc.read_line(1000, nullptr);
+    ASSERT_TRUE(line.has_value());
+    EXPECT_EQ(*line, "524288");
+}
+
+TEST(LauncherTest, ChildLeadsOwnProcessGroup) {
+    Sys::Process proc("sleep 1");
+    ASSERT_TRUE(proc.start(0));
+    EXPECT_EQ(getpgid(proc.pid()), proc.pid());
+    proc.terminate();
+}
+
+TEST(LauncherTest, MissingExecutableExits127) {
+    auto c = Sys::Launcher::command("/nonexistent/arena-bot");
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    pid_t pid = Sys::Launcher::spawn(*c, {}, 0, fds[0], fds[1]);
+    ASSERT_GT(pid, 0);
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 127);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(LauncherTest, DISABLED_BenchmarkSpawnRate) {
+    auto c = Sys::Launcher::command("true");
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    constexpr int spawns = 200;
+
+    for (size_t mb : {0, 256, 1024, 3072}) {
+        std::vector<char> heap(mb << 20);
+        for (size_t i = 0; i < heap.size(); i += 4096) heap[i] = 1;
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < spawns; ++i) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                execv(c->path.c_str(), c->argv.data());
+                _exit(127);
+            }
+            waitpid(pid, nullptr, 0);
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        for (int i = 0; i < spawns; ++i)
+            waitpid(Sys::Launcher::spawn(*c, {}, 0, fds[0], fds[1]), nullptr, 0);
+        auto t2 = std::chrono::steady_clock::now();
+
+        std::printf(
+            "heap %4zu MB: fork %7.0f spawns/s, launcher %7.0f spawns/s\n", mb,
+            spawns / std::chrono::duration<double>(t1 - t0).count(),
+            spawns / std::chrono::duration<double>(t2 - t1).count()
+        );
+    }
+    close(fds[0]);
+    close(fds[1]);
+}
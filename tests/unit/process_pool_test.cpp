@@ -0,0 +1,98 @@
+#include "../common/test_utils.h"
+#include "../src/sys/process_pool.h"
+
+using namespace Arena;
+
+class ProcessPoolTest : public ::testing::Test {
+protected:
+    static std::unique_ptr<Sys::Process> make_proc() {
+        return std::make_unique<TestHelpers::MockProcess>(
+            [](const std::string&) { return std::string("OK"); }
+        );
+    }
+};
+
+TEST_F(ProcessPoolTest, EmptyPoolMisses) {
+    Sys::ProcessPool pool(4);
+    EXPECT_EQ(pool.acquire("a"), nullptr);
+}
+
+TEST_F(ProcessPoolTest, ReleaseThenAcquire) {
+    Sys::ProcessPool pool(4);
+    auto proc = make_proc();
+    auto* raw = proc.get();
+
+    EXPECT_TRUE(pool.release("a", std::move(proc)));
+    EXPECT_EQ(pool.idle(), 1);
+    EXPECT_EQ(pool.acquire("b"), nullptr);
+
+    auto back = pool.acquire("a");
+    EXPECT_EQ(back.get(), raw);
+    EXPECT_EQ(pool.idle(), 0);
+    EXPECT_EQ(pool.stats().reused, 1);
+}
+
+TEST_F(ProcessPoolTest, CapacityPerKey) {
+    Sys::ProcessPool pool(1);
+    EXPECT_TRUE(pool.release("a", make_proc()));
+    EXPECT_FALSE(pool.release("a", make_proc()));
+    EXPECT_TRUE(pool.release("b", make_proc()));
+    EXPECT_EQ(pool.stats().discarded, 1);
+}
+
+TEST_F(ProcessPoolTest, DeadProcessDiscarded) {
+    Sys::ProcessPool pool(4);
+    EXPECT_FALSE(pool.release("a", std::make_unique<Sys::Process>("true")));
+    EXPECT_EQ(pool.idle(), 0);
+}
+
+TEST_F(ProcessPoolTest, UnsupportedKeyDrained) {
+    Sys::ProcessPool pool(4);
+    pool.release("a", make_proc());
+    pool.mark_unsupported("a");
+
+    EXPECT_EQ(pool.idle(), 0);
+    EXPECT_FALSE(pool.release("a", make_proc()));
+}
+
+TEST_F(ProcessPoolTest, ReserveUpToWanted) {
+    Sys::ProcessPool pool(4, false);
+    EXPECT_TRUE(pool.reserve("a", 2));
+    EXPECT_TRUE(pool.reserve("a", 2));
+    EXPECT_FALSE(pool.reserve("a", 2));
+    EXPECT_TRUE(pool.reserve("a", 3, false));
+    EXPECT_FALSE(pool.reserve("a", 2, false));
+    EXPECT_TRUE(pool.reserve("b", 1));
+    EXPECT_EQ(pool.reserved(), 3u);
+}
+
+TEST_F(ProcessPoolTest, PrimedFillAndAcquire) {
+    Sys::ProcessPool pool(4, false);
+    ASSERT_TRUE(pool.reserve("a", 1));
+    pool.fill("a", make_proc(), 250);
+    EXPECT_FALSE(pool.reserve("a", 1));
+
+    bool primed = false;
+    auto proc = pool.acquire("a", &primed);
+    ASSERT_NE(proc, nullptr);
+    EXPECT_TRUE(primed);
+
+    auto st = pool.stats();
+    EXPECT_EQ(st.primed, 1);
+    EXPECT_EQ(st.primed_used, 1);
+    EXPECT_EQ(st.hidden_ms, 250);
+}
+
+TEST_F(ProcessPoolTest, CancelReleasesReservation) {
+    Sys::ProcessPool pool(4, false);
+    ASSERT_TRUE(pool.reserve("a", 1));
+    pool.cancel("a");
+    EXPECT_TRUE(pool.reserve("a", 1));
+}
+
+TEST_F(ProcessPoolTest, NoReuseDiscardsReturns) {
+    Sys::ProcessPool pool(4, false);
+    EXPECT_FALSE(pool.reuse());
+    EXPECT_FALSE(pool.release("a", make_proc()));
+    EXPECT_EQ(pool.idle("a"), 0);
+}
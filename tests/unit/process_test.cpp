@@ -1,5 +1,6 @@
 #include "../common/test_utils.h"
 #include "../src/sys/process.h"
+#include "../src/sys/reactor.h"
 
 using namespace Arena;
 
@@ -59,6 +60,80 @@ TEST_F(ProcessTest, ZombieReaping) {
     EXPECT_EQ(errno, ESRCH);
 }
 
+TEST_F(ProcessTest, TerminateReturnsOnExit) {
+    Sys::Process proc("sh -c 'read l; exit 0'");
+    ASSERT_TRUE(proc.start(0));
+    EXPECT_GE(proc.exit_fd(), 0);
+
+    auto start = std::chrono::steady_clock::now();
+    proc.terminate();
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start
+    ).count();
+    EXPECT_LT(ms, Core::Constants::TERMINATION_GRACE_MS / 2);
+    EXPECT_EQ(proc.exit_fd(), -1);
+}
+
+TEST_F(ProcessTest, TerminateKillsAfterGrace) {
+    Sys::Process proc("sleep 5");
+    ASSERT_TRUE(proc.start(0));
+    int pid = proc.pid();
+
+    auto start = std::chrono::steady_clock::now();
+    proc.terminate();
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start
+    ).count();
+    EXPECT_GE(ms, Core::Constants::TERMINATION_GRACE_MS - 5);
+    EXPECT_LT(ms, 2000);
+    EXPECT_EQ(kill(pid, 0), -1);
+}
+
+TEST_F(ProcessTest, RetireReapsThroughReactor) {
+    Sys::Reactor r;
+    ASSERT_TRUE(r.valid());
+    auto proc = std::make_unique<Sys::Process>("sh -c 'read l; exit 0'");
+    ASSERT_TRUE(proc->start(0));
+    int pid = proc->pid();
+
+    Sys::Process::retire(std::move(proc), r);
+    EXPECT_EQ(r.pending(), 1u);
+    while (r.pending()) r.run_once(1000);
+
+    EXPECT_EQ(kill(pid, 0), -1);
+    EXPECT_EQ(errno, ESRCH);
+}
+
+TEST_F(ProcessTest, RetireKillsUnresponsive) {
+    Sys::Reactor r;
+    auto proc = std::make_unique<Sys::Process>("sleep 5");
+    ASSERT_TRUE(proc->start(0));
+    int pid = proc->pid();
+
+    auto start = std::chrono::steady_clock::now();
+    Sys::Process::retire(std::move(proc), r);
+    while (r.pending()) r.run_once(1000);
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start
+    ).count();
+
+    EXPECT_GE(ms, Core::Constants::TERMINATION_GRACE_MS - 5);
+    EXPECT_EQ(kill(pid, 0), -1);
+    EXPECT_EQ(errno, ESRCH);
+}
+
+TEST_F(ProcessTest, CpuTimeOfBusyChild) {
+    Sys::Process proc("sh -c 'while :; do :; done'");
+    ASSERT_TRUE(proc.start(0));
+    long long start = proc.get_cpu_ns();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    long long spent = proc.get_cpu_ns() - start;
+    proc.terminate();
+
+    EXPECT_GT(spent, 20000000);
+    EXPECT_EQ(proc.get_cpu_ns(), 0);
+}
+
 TEST_F(ProcessTest, ReadTimeout) {
     Sys::Process proc("sleep 10");
     ASSERT_TRUE(proc.start(0));
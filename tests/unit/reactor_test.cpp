@@ -0,0 +1,130 @@
+#include "../common/test_utils.h"
+#include "../src/sys/reactor.h"
+
+using namespace Arena;
+
+class ReactorTest : public ::testing::Test {
+protected:
+    int fds[2] = {-1, -1};
+
+    void SetUp() override { ASSERT_EQ(pipe(fds), 0); }
+    void TearDown() override {
+        if (fds[0] != -1) close(fds[0]);
+        if (fds[1] != -1) close(fds[1]);
+    }
+};
+
+TEST_F(ReactorTest, FiresOnReadable) {
+    Sys::Reactor r;
+    ASSERT_TRUE(r.valid());
+
+    int fired = 0;
+    auto deadline = Sys::Reactor::Clock::now() + std::chrono::seconds(10);
+    ASSERT_TRUE(r.watch(fds[0], deadline, [&] { fired++; }));
+    EXPECT_EQ(r.pending(), 1);
+
+    ASSERT_EQ(write(fds[1], "x\n", 2), 2);
+    EXPECT_EQ(r.run_once(1000), 1);
+    EXPECT_EQ(fired, 1);
+    EXPECT_EQ(r.pending(), 0);
+}
+
+TEST_F(ReactorTest, FiresOnDeadline) {
+    Sys::Reactor r;
+    int fired = 0;
+    auto start = Sys::Reactor::Clock::now();
+    ASSERT_TRUE(r.watch(fds[0], start + std::chrono::milliseconds(20), [&] { fired++; }));
+
+    while (!fired) r.run_once(1000);
+    auto waited = std::chrono::duration_cast<std::chrono::milliseconds>(
+        Sys::Reactor::Clock::now() - start
+    ).count();
+
+    EXPECT_EQ(fired, 1);
+    EXPECT_GE(waited, 20);
+    EXPECT_LT(waited, 100);
+}
+
+TEST_F(ReactorTest, FiresOnHangup) {
+    Sys::Reactor r;
+    int fired = 0;
+    auto deadline = Sys::Reactor::Clock::now() + std::chrono::seconds(10);
+    ASSERT_TRUE(r.watch(fds[0], deadline, [&] { fired++; }));
+
+    close(fds[1]);
+    fds[1] = -1;
+    EXPECT_EQ(r.run_once(1000), 1);
+    EXPECT_EQ(fired, 1);
+}
+
+TEST_F(ReactorTest, OneShot) {
+    Sys::Reactor r;
+    int fired = 0;
+    auto deadline = Sys::Reactor::Clock::now() + std::chrono::milliseconds(10);
+    ASSERT_TRUE(r.watch(fds[0], deadline, [&] { fired++; }));
+    ASSERT_EQ(write(fds[1], "x", 1), 1);
+
+    r.run_once(1000);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    r.run_once(0);
+    EXPECT_EQ(fired, 1);
+}
+
+TEST_F(ReactorTest, RewatchAfterFire) {
+    Sys::Reactor r;
+    int fired = 0;
+    auto deadline = Sys::Reactor::Clock::now() + std::chrono::seconds(10);
+    ASSERT_EQ(write(fds[1], "x", 1), 1);
+
+    ASSERT_TRUE(r.watch(fds[0], deadline, [&] { fired++; }));
+    r.run_once(1000);
+    ASSERT_TRUE(r.watch(fds[0], deadline, [&] { fired++; }));
+    r.run_once(1000);
+    EXPECT_EQ(fired, 2);
+}
+
+TEST_F(ReactorTest, WakeFromOtherThread) {
+    Sys::Reactor r;
+    int fired = 0;
+    std::thread t([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        r.watch(fds[0], Sys::Reactor::Clock::now(), [&] { fired++; });
+    });
+
+    auto start = Sys::Reactor::Clock::now();
+    while (!fired && Sys::Reactor::Clock::now() - start < std::chrono::seconds(2))
+        r.run_once(5000);
+    t.join();
+    EXPECT_EQ(fired, 1);
+}
+
+TEST_F(ReactorTest, InvalidFdRejected) {
+    Sys::Reactor r;
+    EXPECT_FALSE(r.watch(-1, Sys::Reactor::Clock::now(), [] {}));
+    EXPECT_EQ(r.pending(), 0);
+}
+
+TEST_F(ReactorTest, DestroyDropsCallbacksThatRewatch) {
+    int dropped = 0;
+    {
+        auto r = std::make_unique<Sys::Reactor>();
+        auto deadline = Sys::Reactor::Clock::now() + std::chrono::seconds(10);
+        struct Rewatch {
+            Sys::Reactor* r = nullptr;
+            int fd = -1;
+            int* dropped = nullptr;
+            ~Rewatch() {
+                (*dropped)++;
+                r->watch(fd, Sys::Reactor::Clock::now(), [] {});
+            }
+        };
+        auto guard = std::make_shared<Rewatch>();
+        guard->r = r.get();
+        guard->fd = fds[1];
+        guard->dropped = &dropped;
+        ASSERT_TRUE(r->watch(fds[0], deadline, [guard] {}));
+        guard.reset();
+        r.reset();
+    }
+    EXPECT_EQ(dropped, 1);
+}
@@ -47,7 +47,7 @@ TEST_F(RefereeTest, OutOfBounds) {
 }
 
 TEST_F(RefereeTest, OccupiedCell) {
-    ref->board_[0] = 1;
+    ref->board_.place(0, 0, 1);
     EXPECT_THROW(ref->parse_and_validate_move("0,0"), Core::PlayerError);
 }
 
@@ -77,7 +77,7 @@ TEST_F(RefereeTest, LastMoverLeg1) {
 }
 
 TEST_F(RefereeTest, BoardFullDetection) {
-    for (int i = 0; i < 225; ++i) ref->board_[i] = 1;
+    for (int i = 0; i < 225; ++i) ref->board_.place(i % 15, i / 15, 1);
     ref->moves_ = 225;
     std::vector<Core::Point> h;
     EXPECT_GE(ref->moves_, 15 * 15);
@@ -116,7 +116,7 @@ TEST_F(RefereeTest, GetOpeningSize) {
 }
 
 TEST_F(RefereeTest, MoveHistoryEmpty) {
-    EXPECT_TRUE(ref->hist_.empty());
+    EXPECT_TRUE(ref->history().empty());
 }
 
 TEST_F(RefereeTest, OpeningValidationOOB) {
@@ -128,7 +128,7 @@ TEST_F(RefereeTest, OpeningValidationOOB) {
 }
 
 TEST_F(RefereeTest, OpeningValidationOccupied) {
-    ref->board_[7 * 15 + 7] = 1;
+    ref->board_.place(7, 7, 1);
     Core::Point occupied = {7, 7};
     EXPECT_THROW(ref->validate_opening_move(occupied), std::runtime_error);
 }
@@ -139,17 +139,34 @@ TEST_F(RefereeTest, ApplyMoveUpdatesState) {
     ref->apply_move(m);
 
     EXPECT_EQ(ref->moves_, 1);
-    EXPECT_EQ(ref->hist_.size(), 1);
-    EXPECT_EQ(ref->board_[7 * 15 + 7], static_cast<int>(Core::PlayerColor::BLACK));
+    EXPECT_EQ(ref->history().size(), 1);
+    EXPECT_EQ(ref->board_.at(7, 7), static_cast<int>(Core::PlayerColor::BLACK));
 }
 
 TEST_F(RefereeTest, ApplyMoveAlternatesColors) {
     ref->moves_ = 0;
     ref->apply_move({5, 5});
-    EXPECT_EQ(ref->board_[5 * 15 + 5], 1);
+    EXPECT_EQ(ref->board_.at(5, 5), 1);
 
     ref->apply_move({6, 6});
-    EXPECT_EQ(ref->board_[6 * 15 + 6], 2);
+    EXPECT_EQ(ref->board_.at(6, 6), 2);
+}
+
+TEST_F(RefereeTest, PositionKeysTrackHistory) {
+    Analysis::Zobrist::init(15);
+    p.opening = {{7, 7}, {8, 8}};
+    ref = std::make_unique<Game::Referee>(
+        p, nullptr, stats, TestHelpers::make_handler()
+    );
+    ref->apply_opening_moves();
+    ref->apply_move({6, 8});
+    ref->apply_move({9, 7});
+
+    ASSERT_EQ(ref->position_keys().size(), 4u);
+    for (size_t i = 1; i <= ref->history().size(); ++i) {
+        auto prefix = ref->history().prefix(i);
+        EXPECT_EQ(ref->position_keys()[i - 1], Analysis::Zobrist::canonical(prefix, 15));
+    }
 }
 
 TEST_F(RefereeTest, ResultCallback) {
@@ -1,5 +1,9 @@
 #include "../common/test_utils.h"
 #include "../src/game/rules.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
 
 using namespace Arena;
 
@@ -121,3 +125,186 @@ TEST_F(RulesTest, NoWinWrongColor) {
     for (int i = 0; i < 5; ++i) Set(i, 0, 1);
     EXPECT_FALSE(Game::Rules::check_win(board, size, 0, 0, 2));
 }
+
+TEST(BitboardTest, PlaceAndQuery) {
+    Game::Bitboard b(40);
+    b.place(39, 0, 1);
+    b.place(0, 39, 2);
+    EXPECT_EQ(b.at(39, 0), 1);
+    EXPECT_EQ(b.at(0, 39), 2);
+    EXPECT_EQ(b.at(1, 1), 0);
+    EXPECT_TRUE(b.occupied(39, 0));
+    EXPECT_FALSE(b.occupied(38, 0));
+}
+
+TEST(BitboardTest, EdgeLinesOnEverySize) {
+    using Core::Constants::MAX_BOARD_SIZE;
+    using Core::Constants::MIN_BOARD_SIZE;
+    for (int n = MIN_BOARD_SIZE; n <= MAX_BOARD_SIZE; ++n) {
+        SCOPED_TRACE("size " + std::to_string(n));
+        Game::Bitboard row(n), col(n), diag(n), anti(n);
+        for (int i = 0; i < 5; ++i) {
+            row.place(n - 1 - i, n - 1, 1);
+            col.place(n - 1, n - 1 - i, 2);
+            diag.place(n - 1 - i, n - 1 - i, 1);
+            anti.place(n - 1 - i, i, 2);
+        }
+        EXPECT_TRUE(Game::Rules::check_win(row, n - 1, n - 1, 1));
+        EXPECT_TRUE(Game::Rules::check_win(col, n - 1, n - 5, 2));
+        EXPECT_TRUE(Game::Rules::check_win(diag, n - 3, n - 3, 1));
+        EXPECT_TRUE(Game::Rules::check_win(anti, n - 5, 4, 2));
+        EXPECT_FALSE(Game::Rules::check_win(row, n - 1, n - 1, 2));
+    }
+}
+
+TEST(BitboardTest, MatchesScanOnEverySize) {
+    using Core::Constants::MAX_BOARD_SIZE;
+    using Core::Constants::MIN_BOARD_SIZE;
+    std::mt19937 rng(12345);
+    for (int n = MIN_BOARD_SIZE; n <= MAX_BOARD_SIZE; ++n) {
+        for (int round = 0; round < 4; ++round) {
+            std::vector<int> board(n * n, 0);
+            Game::Bitboard bits(n);
+            std::vector<int> cells(n * n);
+            for (int i = 0; i < n * n; ++i) cells[i] = i;
+            std::shuffle(cells.begin(), cells.end(), rng);
+            int stones = n * n * (round + 1) / 6;
+            for (int i = 0; i < stones; ++i) {
+                int x = cells[i] % n, y = cells[i] / n, c = 1 + i % 2;
+                board[cells[i]] = c;
+                bits.place(x, y, c);
+            }
+            for (int y = 0; y < n; ++y)
+                for (int x = 0; x < n; ++x)
+                    for (int c = 1; c <= 2; ++c) {
+                        if (board[y * n + x] != c) continue;
+                        ASSERT_EQ(
+                            Game::Rules::check_win(bits, x, y, c),
+                            Game::Rules::check_win(board, n, x, y, c)
+                        ) << "size " << n << " at " << x << "," << y;
+                    }
+        }
+    }
+}
+
+TEST(BitboardTest, DISABLED_BenchmarkAgainstScan) {
+    for (int n : {15, 20, 40}) {
+        std::mt19937 rng(n);
+        std::vector<int> board(n * n, 0);
+        Game::Bitboard bits(n);
+        std::vector<std::pair<int, int>> probes;
+        for (int i = 0; i < n * n / 3; ++i) {
+            int x = (int)(rng() % n), y = (int)(rng() % n);
+            if (board[y * n + x]) continue;
+            board[y * n + x] = 1 + i % 2;
+            bits.place(x, y, 1 + i % 2);
+            probes.push_back({x, y});
+        }
+
+        constexpr int reps = 20000;
+        int hits = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        for (int r = 0; r < reps; ++r)
+            for (auto [x, y] : probes)
+                hits += Game::Rules::check_win(board, n, x, y, board[y * n + x]);
+        auto t1 = std::chrono::steady_clock::now();
+        for (int r = 0; r < reps; ++r)
+            for (auto [x, y] : probes)
+                hits -= Game::Rules::check_win(bits, x, y, board[y * n + x]);
+        auto t2 = std::chrono::steady_clock::now();
+
+        double calls = (double)reps * probes.size();
+        std::printf(
+            "size %2d: scan %.1f ns/call, bitboard %.1f ns/call\n", n,
+            std::chrono::duration<double, std::nano>(t1 - t0).count() / calls,
+            std::chrono::duration<double, std::nano>(t2 - t1).count() / calls
+        );
+        EXPECT_EQ(hits, 0);
+    }
+}
+
+class RuleJudgeTest : public ::testing::Test {
+protected:
+    Game::Bitboard board{15};
+
+    void Stones(std::initializer_list<Core::Point> pts, int c) {
+        for (auto p : pts) board.place(p.x, p.y, c);
+    }
+
+    Game::Rules::Verdict Play(Core::Rule rule, int x, int y, int c) {
+        board.place(x, y, c);
+        return Game::Rules::judge_for(rule)(board, x, y, c);
+    }
+};
+
+TEST_F(RuleJudgeTest, FreestyleOverlineWins) {
+    Stones({{2, 7}, {3, 7}, {4, 7}, {6, 7}, {7, 7}}, 1);
+    EXPECT_EQ(Play(Core::Rule::FREESTYLE, 5, 7, 1), Game::Rules::Verdict::WIN);
+}
+
+TEST_F(RuleJudgeTest, StandardOverlineDoesNotWin) {
+    Stones({{2, 7}, {3, 7}, {4, 7}, {6, 7}, {7, 7}}, 2);
+    EXPECT_EQ(Play(Core::Rule::STANDARD, 5, 7, 2), Game::Rules::Verdict::NONE);
+}
+
+TEST_F(RuleJudgeTest, StandardExactFiveWins) {
+    Stones({{3, 3}, {4, 4}, {6, 6}, {7, 7}}, 2);
+    EXPECT_EQ(Play(Core::Rule::STANDARD, 5, 5, 2), Game::Rules::Verdict::WIN);
+}
+
+TEST_F(RuleJudgeTest, RenjuBlackOverlineForbidden) {
+    Stones({{2, 7}, {3, 7}, {4, 7}, {6, 7}, {7, 7}}, 1);
+    EXPECT_EQ(Play(Core::Rule::RENJU, 5, 7, 1), Game::Rules::Verdict::FORBIDDEN);
+}
+
+TEST_F(RuleJudgeTest, RenjuWhiteOverlineWins) {
+    Stones({{2, 7}, {3, 7}, {4, 7}, {6, 7}, {7, 7}}, 2);
+    EXPECT_EQ(Play(Core::Rule::RENJU, 5, 7, 2), Game::Rules::Verdict::WIN);
+}
+
+TEST_F(RuleJudgeTest, RenjuDoubleFourForbidden) {
+    Stones({{4, 7}, {5, 7}, {6, 7}, {7, 4}, {7, 5}, {7, 6}}, 1);
+    Stones({{3, 7}, {7, 3}}, 2);
+    EXPECT_EQ(Play(Core::Rule::RENJU, 7, 7, 1), Game::Rules::Verdict::FORBIDDEN);
+}
+
+TEST_F(RuleJudgeTest, RenjuDoubleFourInOneLineForbidden) {
+    Stones({{3, 7}, {5, 7}, {6, 7}, {9, 7}}, 1);
+    EXPECT_EQ(Play(Core::Rule::RENJU, 7, 7, 1), Game::Rules::Verdict::FORBIDDEN);
+}
+
+TEST_F(RuleJudgeTest, RenjuDoubleThreeForbidden) {
+    Stones({{5, 7}, {6, 7}, {7, 5}, {7, 6}}, 1);
+    EXPECT_EQ(Play(Core::Rule::RENJU, 7, 7, 1), Game::Rules::Verdict::FORBIDDEN);
+}
+
+TEST_F(RuleJudgeTest, RenjuFourThreeAllowed) {
+    Stones({{4, 7}, {5, 7}, {6, 7}, {7, 5}, {7, 6}}, 1);
+    Stones({{3, 7}}, 2);
+    EXPECT_EQ(Play(Core::Rule::RENJU, 7, 7, 1), Game::Rules::Verdict::NONE);
+}
+
+TEST_F(RuleJudgeTest, RenjuClosedThreeDoesNotCount) {
+    Stones({{5, 7}, {6, 7}, {7, 5}, {7, 6}}, 1);
+    Stones({{4, 7}, {8, 7}}, 2);
+    EXPECT_EQ(Play(Core::Rule::RENJU, 7, 7, 1), Game::Rules::Verdict::NONE);
+}
+
+TEST_F(RuleJudgeTest, RenjuFiveBeatsForbidden) {
+    Stones({{3, 7}, {4, 7}, {5, 7}, {6, 7}, {7, 4}, {7, 5}, {7, 6}}, 1);
+    EXPECT_EQ(Play(Core::Rule::RENJU, 7, 7, 1), Game::Rules::Verdict::WIN);
+}
+
+TEST_F(RuleJudgeTest, RenjuWhiteDoubleThreeAllowed) {
+    Stones({{5, 7}, {6, 7}, {7, 5}, {7, 6}}, 2);
+    EXPECT_EQ(Play(Core::Rule::RENJU, 7, 7, 2), Game::Rules::Verdict::NONE);
+}
+
+TEST(RulesParseTest, NamesAndCodes) {
+    EXPECT_EQ(Game::Rules::parse("freestyle"), Core::Rule::FREESTYLE);
+    EXPECT_EQ(Game::Rules::parse("standard"), Core::Rule::STANDARD);
+    EXPECT_EQ(Game::Rules::parse("renju"), Core::Rule::RENJU);
+    EXPECT_EQ(Game::Rules::parse("4"), Core::Rule::RENJU);
+    EXPECT_THROW(Game::Rules::parse("caro"), std::runtime_error);
+    EXPECT_STREQ(Game::Rules::name(Core::Rule::STANDARD), "standard");
+}
@@ -0,0 +1,135 @@
+#include "../common/test_utils.h"
+#include "../src/app/scheduler.h"
+#include "../src/app/cli.h"
+
+using namespace Arena;
+
+class SchedulerTest : public ::testing::Test {
+protected:
+    using GameParams = App::GameParams;
+
+    std::shared_ptr<App::RunContext> make_run(int pairs, int min_pairs = 1) {
+        auto ctx = std::make_shared<App::RunContext>();
+        ctx->cfg.max_pairs = pairs;
+        ctx->cfg.min_pairs = min_pairs;
+        for (auto& g : App::CLI::create_pending_games(ctx->cfg, {}, std::nullopt, ctx, "id"))
+            queue.push_back(std::move(g));
+        return ctx;
+    }
+
+    GameParams take(App::Scheduler& s) {
+        size_t i = s.pick(queue);
+        auto g = std::move(queue[i]);
+        queue.erase(queue.begin() + i);
+        s.dispatched(g);
+        return g;
+    }
+
+    std::deque<GameParams> queue;
+};
+
+TEST_F(SchedulerTest, IntervalNarrowsWithPairs) {
+    std::array<int, 5> penta = {5, 20, 50, 20, 5};
+    auto few = App::Scheduler::interval(penta, 10, 2.0);
+    auto many = App::Scheduler::interval(penta, 1000, 2.0);
+    EXPECT_NEAR(few.mean, 0.5, 1e-9);
+    EXPECT_GT(few.half_width, many.half_width);
+    EXPECT_NEAR(few.half_width / many.half_width, 10.0, 1e-9);
+}
+
+TEST_F(SchedulerTest, KeepsPairsTogether) {
+    App::Scheduler s({});
+    auto a = make_run(3);
+    auto b = make_run(3);
+
+    auto g1 = take(s);
+    auto g2 = take(s);
+    EXPECT_EQ(g1.context, g2.context);
+    EXPECT_EQ(g1.pair, g2.pair);
+    EXPECT_EQ(g1.leg, 0);
+    EXPECT_EQ(g2.leg, 1);
+}
+
+TEST_F(SchedulerTest, RoundRobinsUntilMinPairs) {
+    App::Scheduler s({});
+    auto a = make_run(10, 3);
+    auto b = make_run(10, 3);
+
+    std::map<App::RunContext*, int> legs;
+    for (int i = 0; i < 12; ++i) legs[take(s).context.get()]++;
+    EXPECT_EQ(legs[a.get()], 6);
+    EXPECT_EQ(legs[b.get()], 6);
+}
+
+TEST_F(SchedulerTest, FavoursWiderInterval) {
+    App::Scheduler s({});
+    auto a = make_run(10);
+    auto b = make_run(10);
+    take(s); take(s);
+    take(s); take(s);
+
+    a->match_state.penta = {0, 0, 1, 0, 0};
+    b->match_state.penta = {1, 0, 0, 0, 1};
+    EXPECT_EQ(take(s).context, b);
+}
+
+TEST_F(SchedulerTest, StoppedRunsDrainFirst) {
+    App::Scheduler s({});
+    auto a = make_run(2);
+    auto b = make_run(2);
+    b->stop_flag = true;
+
+    EXPECT_EQ(take(s).context, b);
+}
+
+TEST_F(SchedulerTest, BudgetStopsRemainingRuns) {
+    App::Scheduler s({2});
+    auto a = make_run(5);
+    auto b = make_run(5);
+
+    for (int i = 0; i < 4; ++i) take(s);
+    EXPECT_EQ(s.scheduled(), 2);
+    EXPECT_FALSE(a->stop_flag);
+
+    take(s);
+    EXPECT_TRUE(a->stop_flag);
+    EXPECT_TRUE(b->stop_flag);
+}
+
+TEST_F(SchedulerTest, DecidedNeedsClearMargin) {
+    App::Scheduler s({});
+    App::MatchState state;
+    Core::Config cfg;
+    cfg.min_pairs = 5;
+
+    state.penta = {0, 0, 0, 0, 4};
+    state.pairs_done = 4;
+    EXPECT_FALSE(s.decided(state, cfg));
+
+    state.penta = {0, 1, 2, 10, 20};
+    state.pairs_done = 33;
+    EXPECT_TRUE(s.decided(state, cfg));
+
+    state.penta = {5, 10, 20, 10, 5};
+    state.pairs_done = 50;
+    EXPECT_FALSE(s.decided(state, cfg));
+}
+
+TEST_F(SchedulerTest, SpendingWidensWithLooks) {
+    double first = App::Scheduler::spending_z(0.01, 1);
+    EXPECT_GT(first, 2.576);
+    EXPECT_GT(App::Scheduler::spending_z(0.01, 100), first);
+    EXPECT_NEAR(std::erfc(first / std::sqrt(2.0)), 0.01 * 6.0 / (M_PI * M_PI), 1e-9);
+}
+
+TEST_F(SchedulerTest, DecidedCorrectsForRepeatedLooks) {
+    App::Scheduler s({});
+    App::MatchState state;
+    Core::Config cfg;
+    state.penta = {30, 0, 100, 0, 70};
+    state.pairs_done = 200;
+
+    auto fixed = App::Scheduler::interval(state.penta, 200, 2.576);
+    EXPECT_GT(std::abs(fixed.mean - 0.5), fixed.half_width);
+    EXPECT_FALSE(s.decided(state, cfg));
+}
@@ -1,6 +1,9 @@
 #include "../common/test_utils.h"
 #include "../src/stats/tracker.h"
 #include "../src/stats/sprt.h"
+#include "../src/stats/queue_wait.h"
+#include "../src/stats/bradley_terry.h"
+#include <random>
 
 using namespace Arena;
 
@@ -65,6 +68,42 @@ TEST_F(StatsTest, MetricsThresholds) {
     EXPECT_EQ(stats.p1_critical_success, 1);
 }
 
+TEST_F(StatsTest, SnapshotRoundTrip) {
+    stats.update_elo(1.0);
+    stats.add_metrics(1, 0.123456789, 0.06);
+    stats.add_metrics(2, 0.3, 0.0);
+    stats.add_crash(2);
+
+    Stats::Tracker copy;
+    ASSERT_TRUE(copy.restore(stats.snapshot()));
+    EXPECT_EQ(copy.snapshot(), stats.snapshot());
+    EXPECT_EQ(copy.p1_elo, stats.p1_elo);
+    EXPECT_DOUBLE_EQ(copy.p1_sum_weighted_sq_err, stats.p1_sum_weighted_sq_err);
+    EXPECT_EQ(copy.p2_severe_errors, 1);
+    EXPECT_EQ(copy.p2_crashes.load(), 1);
+    EXPECT_EQ(copy.games.load(), 1);
+
+    EXPECT_FALSE(copy.restore("1000 1000 0.5"));
+    EXPECT_EQ(copy.p1_elo, stats.p1_elo);
+}
+
+TEST_F(StatsTest, MergeAddsMetricsAndCrashes) {
+    stats.update_elo(1.0);
+    stats.add_metrics(1, 0.1, 0.0);
+
+    Stats::Tracker game;
+    game.update_elo(0.0);
+    game.add_metrics(1, 0.2, 0.06);
+    game.add_crash(2);
+    stats.merge(game);
+
+    EXPECT_EQ(stats.p1_moves_analyzed, 2);
+    EXPECT_EQ(stats.p1_critical_total, 1);
+    EXPECT_EQ(stats.p2_crashes.load(), 1);
+    EXPECT_EQ(stats.games.load(), 1);
+    EXPECT_GT(stats.p1_elo, Core::Constants::ELO_BASE);
+}
+
 TEST_F(StatsTest, CrashCounting) {
     stats.add_crash(1);
     stats.add_crash(2);
@@ -236,3 +275,160 @@ TEST_F(StatsTest, SPRTNoRisk) {
     state.losses = 0;
     EXPECT_FALSE(Stats::SPRT::check(state, cfg));
 }
+
+TEST_F(StatsTest, SPRTExpectedScore) {
+    EXPECT_DOUBLE_EQ(Stats::SPRT::expected_score(0), 0.5);
+    EXPECT_NEAR(Stats::SPRT::expected_score(400), 10.0 / 11.0, 1e-12);
+    EXPECT_NEAR(Stats::SPRT::expected_score(-400), 1.0 / 11.0, 1e-12);
+}
+
+TEST_F(StatsTest, SPRTBounds) {
+    auto [lower, upper] = Stats::SPRT::bounds(0.05, 0.05);
+    EXPECT_NEAR(lower, -2.944, 1e-3);
+    EXPECT_NEAR(upper, 2.944, 1e-3);
+}
+
+TEST_F(StatsTest, SPRTLLRSign) {
+    EXPECT_DOUBLE_EQ(Stats::SPRT::llr({0, 0, 0, 0, 0}, 0, 5), 0.0);
+    EXPECT_GT(Stats::SPRT::llr({1, 5, 20, 30, 10}, 0, 5), 0.0);
+    EXPECT_LT(Stats::SPRT::llr({5, 15, 30, 15, 5}, 0, 5), 0.0);
+    EXPECT_LT(Stats::SPRT::llr({10, 30, 20, 5, 1}, 0, 5), 0.0);
+}
+
+TEST_F(StatsTest, SPRTLLRMatchesNormalApproximation) {
+    Stats::SPRT::Penta penta = {40, 200, 500, 220, 50};
+    double n = 0, mean = 0, var = 0;
+    for (int i = 0; i < 5; ++i) { n += penta[i]; mean += penta[i] * i / 4.0; }
+    mean /= n;
+    for (int i = 0; i < 5; ++i) var += penta[i] * pow(i / 4.0 - mean, 2);
+    var /= n;
+
+    double s0 = Stats::SPRT::expected_score(0), s1 = Stats::SPRT::expected_score(10);
+    double approx = n * (s1 - s0) * (2 * mean - s0 - s1) / (2 * var);
+    double exact = Stats::SPRT::llr(penta, 0, 10);
+    EXPECT_NEAR(exact, approx, std::abs(approx) * 0.05);
+}
+
+TEST_F(StatsTest, SPRTAcceptsStrongerPlayer) {
+    App::MatchState state;
+    Core::Config cfg;
+    cfg.min_pairs = 1;
+    cfg.max_pairs = 100000;
+    cfg.sprt.enabled = true;
+    cfg.sprt.elo0 = 0;
+    cfg.sprt.elo1 = 20;
+
+    std::mt19937 rng(7);
+    std::discrete_distribution<int> outcome({3, 15, 40, 27, 15});
+    auto d = Stats::SPRT::Decision::NONE;
+    while (d == Stats::SPRT::Decision::NONE && state.pairs_done < cfg.max_pairs) {
+        state.penta[outcome(rng)]++;
+        state.pairs_done++;
+        if (Stats::SPRT::check(state, cfg)) d = Stats::SPRT::decide(state, cfg);
+    }
+    EXPECT_EQ(d, Stats::SPRT::Decision::ACCEPT_H1);
+    EXPECT_LT(state.pairs_done, 2000);
+}
+
+TEST_F(StatsTest, SPRTAcceptsEqualPlayers) {
+    App::MatchState state;
+    Core::Config cfg;
+    cfg.min_pairs = 1;
+    cfg.max_pairs = 100000;
+    cfg.sprt.enabled = true;
+    cfg.sprt.elo0 = 0;
+    cfg.sprt.elo1 = 20;
+
+    std::mt19937 rng(11);
+    std::discrete_distribution<int> outcome({10, 20, 40, 20, 10});
+    auto d = Stats::SPRT::Decision::NONE;
+    while (d == Stats::SPRT::Decision::NONE && state.pairs_done < cfg.max_pairs) {
+        state.penta[outcome(rng)]++;
+        state.pairs_done++;
+        if (Stats::SPRT::check(state, cfg)) d = Stats::SPRT::decide(state, cfg);
+    }
+    EXPECT_EQ(d, Stats::SPRT::Decision::ACCEPT_H0);
+}
+
+TEST_F(StatsTest, SPRTHonoursMinPairs) {
+    App::MatchState state;
+    Core::Config cfg;
+    cfg.min_pairs = 100;
+    cfg.sprt.enabled = true;
+    cfg.sprt.elo1 = 20;
+    state.penta = {0, 4, 20, 36, 20};
+    state.pairs_done = 80;
+    EXPECT_EQ(Stats::SPRT::decide(state, cfg), Stats::SPRT::Decision::ACCEPT_H1);
+    EXPECT_FALSE(Stats::SPRT::check(state, cfg));
+}
+
+TEST(BradleyTerryTest, EqualPlayers) {
+    Stats::BradleyTerry bt(3);
+    for (int i = 0; i < 10; ++i) {
+        bt.add(0, 1, 0.5); bt.add(1, 2, 1.0); bt.add(2, 1, 1.0); bt.add(0, 2, 0.5);
+    }
+    auto r = bt.fit();
+    ASSERT_EQ(r.size(), 3u);
+    for (const auto& x : r) EXPECT_NEAR(x.elo, 0.0, 1e-6);
+    EXPECT_DOUBLE_EQ(r[0].error, 0.0);
+    EXPECT_GT(r[1].error, 0.0);
+    EXPECT_EQ(r[1].games, 30);
+    EXPECT_NEAR(r[1].score, 0.5, 1e-9);
+}
+
+TEST(BradleyTerryTest, RecoversTwoPlayerElo) {
+    Stats::BradleyTerry bt(2);
+    for (int i = 0; i < 750; ++i) bt.add(1, 0, 1.0);
+    for (int i = 0; i < 250; ++i) bt.add(1, 0, 0.0);
+    auto r = bt.fit();
+    EXPECT_NEAR(r[1].elo, 400.0 * std::log10(3.0), 1.0);
+
+    double se = 1.0 / std::sqrt(1000 * 0.75 * 0.25);
+    EXPECT_NEAR(r[1].error, 1.96 * se * 400.0 / std::log(10.0), 0.5);
+}
+
+TEST(BradleyTerryTest, JointRatingUsesIndirectGames) {
+    Stats::BradleyTerry bt(3);
+    for (int i = 0; i < 100; ++i) {
+        bt.add(0, 1, i % 4 == 0 ? 0.0 : 1.0);
+        bt.add(1, 2, i % 4 == 0 ? 0.0 : 1.0);
+    }
+    auto r = bt.fit();
+    EXPECT_LT(r[1].elo, 0.0);
+    EXPECT_LT(r[2].elo, r[1].elo);
+    EXPECT_GT(r[2].error, r[1].error);
+}
+
+TEST(BradleyTerryTest, PerfectScoreStaysFinite) {
+    Stats::BradleyTerry bt(2);
+    for (int i = 0; i < 20; ++i) bt.add(0, 1, 1.0);
+    auto r = bt.fit();
+    EXPECT_TRUE(std::isfinite(r[1].elo));
+    EXPECT_LT(r[1].elo, -300.0);
+}
+
+TEST(QueueWaitTest, EmptySummary) {
+    Stats::QueueWait w;
+    auto s = w.summary();
+    EXPECT_EQ(s.count, 0u);
+    EXPECT_DOUBLE_EQ(s.max_ms, 0.0);
+}
+
+TEST(QueueWaitTest, MeanMaxAndTail) {
+    Stats::QueueWait w;
+    for (int i = 0; i < 99; ++i) w.add(std::chrono::microseconds(100));
+    w.add(std::chrono::milliseconds(50));
+
+    auto s = w.summary();
+    EXPECT_EQ(s.count, 100u);
+    EXPECT_DOUBLE_EQ(s.max_ms, 50.0);
+    EXPECT_NEAR(s.mean_ms, (99 * 0.1 + 50.0) / 100.0, 1e-9);
+    EXPECT_LE(s.p99_ms, 0.128);
+    EXPECT_GE(s.p99_ms, 0.1);
+}
+
+TEST(QueueWaitTest, NegativeDurationClamped) {
+    Stats::QueueWait w;
+    w.add(std::chrono::milliseconds(-5));
+    EXPECT_DOUBLE_EQ(w.summary().max_ms, 0.0);
+}
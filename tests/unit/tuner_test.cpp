@@ -0,0 +1,132 @@
+#include "../common/test_utils.h"
+#include "../src/app/tuner.h"
+#include "../src/core/constants.h"
+#include <cstdio>
+#include <sstream>
+
+using namespace Arena;
+
+class TunerTest : public ::testing::Test {
+protected:
+    std::string path = "/tmp/arena_test_tune.csv";
+
+    void SetUp() override { std::remove(path.c_str()); }
+    void TearDown() override { std::remove(path.c_str()); }
+
+    static std::vector<App::Tuner::Param> parse(const std::string& text, int* k = nullptr) {
+        std::istringstream ss(text);
+        return App::Tuner::parse(ss, k);
+    }
+
+    static App::Tuner make(const std::string& text, int iterations = 100, std::string cp = "") {
+        App::Tuner::Options o;
+        o.iterations = iterations;
+        o.seed = 7;
+        o.checkpoint = std::move(cp);
+        return App::Tuner(parse(text), o);
+    }
+
+    static double value(const std::vector<std::pair<std::string, std::string>>& v, size_t i) {
+        return std::stod(v[i].second);
+    }
+};
+
+TEST_F(TunerTest, ParsesFile) {
+    int k = 0;
+    auto p = parse(
+        "# iteration 12\n"
+        "Aggression, 50, 0, 100, 5, 0.002\n"
+        "\n"
+        "  Decay , 0.5, 0.0, 1.0, 0.05, 0.002  # tail\n", &k
+    );
+    ASSERT_EQ(p.size(), 2u);
+    EXPECT_EQ(k, 12);
+    EXPECT_EQ(p[0].name, "Aggression");
+    EXPECT_TRUE(p[0].integer);
+    EXPECT_DOUBLE_EQ(p[0].value, 50);
+    EXPECT_EQ(p[1].name, "Decay");
+    EXPECT_FALSE(p[1].integer);
+    EXPECT_DOUBLE_EQ(p[1].r_end, 0.002);
+}
+
+TEST_F(TunerTest, RejectsBadLines) {
+    EXPECT_THROW(parse("x, 1, 0, 10\n"), std::runtime_error);
+    EXPECT_THROW(parse("x, 1, 10, 0, 1, 0.1\n"), std::runtime_error);
+    EXPECT_THROW(parse("x, 11, 0, 10, 1, 0.1\n"), std::runtime_error);
+    EXPECT_THROW(parse("x, 1, 0, 10, 0, 0.1\n"), std::runtime_error);
+    EXPECT_THROW(parse("x, one, 0, 10, 1, 0.1\n"), std::runtime_error);
+    EXPECT_THROW(parse("# empty\n"), std::runtime_error);
+}
+
+TEST_F(TunerTest, PerturbationIsSymmetricAndSharedByPair) {
+    auto t = make("x, 50, 0, 100, 5, 0.002\n");
+    auto plus = t.values(0, true);
+    auto minus = t.values(0, false);
+    EXPECT_EQ(plus, t.values(0, true));
+    EXPECT_DOUBLE_EQ(value(plus, 0) + value(minus, 0), 100);
+    EXPECT_GE(std::abs(value(plus, 0) - value(minus, 0)), 10);
+}
+
+TEST_F(TunerTest, UpdateMovesTowardWinner) {
+    auto t = make("x, 50, 0, 100, 5, 0.002\n");
+    double plus = value(t.values(0, true), 0);
+    t.update(0, 2.0);
+    double after = t.params()[0].value;
+    EXPECT_EQ(after > 50, plus > 50);
+    EXPECT_NE(after, 50);
+
+    double before = after;
+    t.values(1, true);
+    t.update(1, 1.0);
+    EXPECT_DOUBLE_EQ(t.params()[0].value, before);
+    EXPECT_EQ(t.iteration(), 2);
+}
+
+TEST_F(TunerTest, DiscardLeavesValuesAlone) {
+    auto t = make("x, 50, 0, 100, 5, 0.002\n");
+    t.values(0, true);
+    t.discard(0);
+    t.update(0, 2.0);
+    EXPECT_DOUBLE_EQ(t.params()[0].value, 50);
+    EXPECT_EQ(t.iteration(), 0);
+}
+
+TEST_F(TunerTest, ClampsToRange) {
+    auto t = make("x, 99, 0, 100, 5, 10\n");
+    for (int i = 0; i < 20; ++i) {
+        auto v = t.values(i, true);
+        EXPECT_LE(value(v, 0), 100);
+        EXPECT_GE(value(v, 0), 0);
+        t.update(i, i % 2 ? 0.0 : 2.0);
+        EXPECT_LE(t.params()[0].value, 100);
+        EXPECT_GE(t.params()[0].value, 0);
+    }
+}
+
+TEST_F(TunerTest, IntegerParametersAreRounded) {
+    auto t = make("n, 5, 0, 10, 1.3, 0.002\nf, 0.5, 0.0, 1.0, 0.13, 0.002\n");
+    auto v = t.values(0, true);
+    EXPECT_EQ(v[0].second.find('.'), std::string::npos);
+    EXPECT_NE(v[1].second.find('.'), std::string::npos);
+}
+
+TEST_F(TunerTest, CheckpointRoundTrip) {
+    auto t = make("x, 50, 0, 100, 5, 0.002\ny, 0.5, 0.0, 1.0, 0.05, 0.002\n", 100, path);
+    for (int i = 0; i < Core::Constants::SPSA_CHECKPOINT_PAIRS; ++i) {
+        t.values(i, true);
+        t.update(i, i % 3 ? 2.0 : 0.5);
+    }
+
+    int k = 0;
+    auto p = App::Tuner::load(path, &k);
+    EXPECT_EQ(k, Core::Constants::SPSA_CHECKPOINT_PAIRS);
+    ASSERT_EQ(p.size(), 2u);
+    auto now = t.params();
+    for (size_t i = 0; i < p.size(); ++i) {
+        EXPECT_EQ(p[i].name, now[i].name);
+        EXPECT_EQ(p[i].integer, now[i].integer);
+        EXPECT_NEAR(p[i].value, now[i].value, 1e-6);
+        EXPECT_DOUBLE_EQ(p[i].min, now[i].min);
+        EXPECT_DOUBLE_EQ(p[i].max, now[i].max);
+    }
+}
@@ -5,6 +5,12 @@ using namespace Arena;
 
 class UtilsTest : public ::testing::Test {};
 
+TEST_F(UtilsTest, CommandName) {
+    EXPECT_EQ(Core::Utils::command_name("./bots/rapfi --nnue x.bin"), "rapfi --nnue x.bin");
+    EXPECT_EQ(Core::Utils::command_name("/usr/bin/engine"), "engine");
+    EXPECT_EQ(Core::Utils::command_name("engine a/b"), "engine a/b");
+}
+
 TEST_F(UtilsTest, DurationParsing) {
     EXPECT_EQ(Core::Utils::parse_duration_ms("100ms"), 100);
     EXPECT_EQ(Core::Utils::parse_duration_ms("1ms"), 1);
@@ -90,3 +90,34 @@ TEST_F(ZobristTest, DifferentBoardSizes) {
 
     EXPECT_NE(h1, h2);
 }
+
+TEST_F(ZobristTest, CanonicalMatchesAcrossSymmetries) {
+    std::vector<Core::Point> game = {{9, 9}, {10, 9}, {9, 11}, {12, 8}, {13, 6}};
+    uint64_t base = Analysis::Zobrist::canonical(game, 20);
+
+    for (int s = 1; s < Analysis::SymmetricHash::SYMMETRIES; ++s) {
+        std::vector<Core::Point> t;
+        for (auto p : game) t.push_back(Analysis::SymmetricHash::transform(p, s, 20));
+        EXPECT_EQ(Analysis::Zobrist::canonical(t, 20), base) << "symmetry " << s;
+    }
+}
+
+TEST_F(ZobristTest, CanonicalKeepsPlayedMoveApart) {
+    std::vector<Core::Point> a = {{9, 9}, {10, 10}, {4, 4}};
+    std::vector<Core::Point> b = {{4, 4}, {10, 10}, {9, 9}};
+
+    EXPECT_EQ(Analysis::Zobrist::hash(a, 20), Analysis::Zobrist::hash(b, 20));
+    EXPECT_NE(Analysis::Zobrist::canonical(a, 20), Analysis::Zobrist::canonical(b, 20));
+}
+
+TEST_F(ZobristTest, SymmetricHashPushPopRestores) {
+    Analysis::SymmetricHash h(20);
+    h.push({9, 9});
+    uint64_t before = h.key({3, 4});
+    h.push({10, 9});
+    h.pop({10, 9});
+
+    EXPECT_EQ(h.key({3, 4}), before);
+    EXPECT_EQ(h.size(), 1u);
+    EXPECT_EQ(before, Analysis::Zobrist::canonical({{9, 9}, {3, 4}}, 20));
+}